@@ -0,0 +1,61 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Relaxed: the counts are statistics, never used to order other memory
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// Over-aligned types, and the blocks std::pmr resources take from upstream
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    size_t rounded = (size + align - 1) / align * align; // aligned_alloc wants a multiple
+    if (void* memory = std::aligned_alloc(align, rounded ? rounded : align)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+AllocationSnapshot AllocationCounter::snapshot() {
+    return AllocationSnapshot{
+        allocationCount.load(std::memory_order_relaxed),
+        allocatedBytes.load(std::memory_order_relaxed)
+    };
+}
+
+AllocationSnapshot AllocationCounter::since(const AllocationSnapshot& earlier) {
+    AllocationSnapshot now = snapshot();
+    return AllocationSnapshot{ now.allocations - earlier.allocations, now.bytes - earlier.bytes };
+}
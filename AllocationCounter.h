@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+
+// Process-wide count of heap allocations made through operator new. The
+// counting operator new lives in AllocationCounter.cpp, so any binary that
+// links it gets the counts; compare snapshots around a piece of work to see
+// how much it allocated.
+struct AllocationSnapshot {
+    size_t allocations;
+    size_t bytes;
+};
+
+class AllocationCounter {
+public:
+    static AllocationSnapshot snapshot();
+    
+    // Allocations and bytes made since an earlier snapshot
+    static AllocationSnapshot since(const AllocationSnapshot& earlier);
+};
@@ -0,0 +1,217 @@
+#include "Archetypes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+EnemyArchetype Archetypes::enemies[ENEMY_TYPE_COUNT] = {
+    DEFAULT_ENEMY_ARCHETYPES[0], DEFAULT_ENEMY_ARCHETYPES[1], DEFAULT_ENEMY_ARCHETYPES[2]
+};
+PowerUpArchetype Archetypes::powerUps[POWERUP_TYPE_COUNT] = {
+    DEFAULT_POWERUP_ARCHETYPES[0], DEFAULT_POWERUP_ARCHETYPES[1],
+    DEFAULT_POWERUP_ARCHETYPES[2], DEFAULT_POWERUP_ARCHETYPES[3]
+};
+std::string Archetypes::tuningPath;
+std::filesystem::file_time_type Archetypes::tuningTime;
+
+namespace {
+
+const char* const ENEMY_NAMES[ENEMY_TYPE_COUNT] = { "goblin", "orc", "skeleton" };
+const char* const POWERUP_NAMES[POWERUP_TYPE_COUNT] = { "health_potion", "damage_boost", "speed_boost", "armor_boost" };
+
+// Override limits. Ranges feed grid query bounds and speeds feed positions,
+// so they stay finite and modest; health has to fit a spawn record.
+const int MAX_HEALTH = 0x7FFF;
+const float MAX_SPEED = 1000.0f;           // Pixels per second
+const float MAX_RANGE = 2000.0f;           // Attack and detection, in pixels
+const float MAX_COOLDOWN = 60.0f;          // Seconds
+const float MAX_PROJECTILE_SPEED = 2000.0f;
+const float MAX_DURATION = 600.0f;         // Seconds
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+bool parseColor(const std::string& value, std::uint8_t& red, std::uint8_t& green, std::uint8_t& blue) {
+    std::istringstream stream(value);
+    int r, g, b;
+    if (!(stream >> r >> g >> b)) return false;
+    red = static_cast<std::uint8_t>(std::clamp(r, 0, 255));
+    green = static_cast<std::uint8_t>(std::clamp(g, 0, 255));
+    blue = static_cast<std::uint8_t>(std::clamp(b, 0, 255));
+    return true;
+}
+
+// Rejects NaN and infinity; anything else is clamped into [low, high]
+bool parseFloat(const std::string& value, float low, float high, float& out) {
+    float parsed = std::stof(value);
+    if (!std::isfinite(parsed)) return false;
+    out = std::clamp(parsed, low, high);
+    return true;
+}
+
+} // namespace
+
+sf::Color Archetypes::color(EnemyType type) {
+    const EnemyArchetype& archetype = enemy(type);
+    return sf::Color(archetype.red, archetype.green, archetype.blue);
+}
+
+sf::Color Archetypes::color(PowerUpType type) {
+    const PowerUpArchetype& archetype = powerUp(type);
+    return sf::Color(archetype.red, archetype.green, archetype.blue);
+}
+
+const char* Archetypes::name(EnemyType type) {
+    return ENEMY_NAMES[static_cast<size_t>(type)];
+}
+
+const char* Archetypes::name(PowerUpType type) {
+    return POWERUP_NAMES[static_cast<size_t>(type)];
+}
+
+float Archetypes::maxDetectionRange() {
+    float range = 0.0f;
+    for (const EnemyArchetype& archetype : enemies) {
+        range = std::max(range, archetype.detectionRange);
+    }
+    return range;
+}
+
+float Archetypes::maxAttackRange() {
+    float range = 0.0f;
+    for (const EnemyArchetype& archetype : enemies) {
+        range = std::max(range, archetype.attackRange);
+    }
+    return range;
+}
+
+std::uint64_t Archetypes::tableHash() {
+    // FNV-1a, with floats taken by bit pattern
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::uint32_t value) {
+        for (int byte = 0; byte < 4; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    auto mixFloat = [&mix](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mix(bits);
+    };
+    
+    for (const EnemyArchetype& archetype : enemies) {
+        mix(static_cast<std::uint32_t>(archetype.health));
+        mix(static_cast<std::uint32_t>(archetype.attack));
+        mix(static_cast<std::uint32_t>(archetype.defense));
+        mixFloat(archetype.speed);
+        mixFloat(archetype.attackRange);
+        mixFloat(archetype.detectionRange);
+        mixFloat(archetype.attackCooldown);
+        mixFloat(archetype.projectileSpeed);
+        mix(static_cast<std::uint32_t>(archetype.experience));
+    }
+    for (const PowerUpArchetype& archetype : powerUps) {
+        mix(static_cast<std::uint32_t>(archetype.effectValue));
+        mixFloat(archetype.effectDuration);
+    }
+    return hash;
+}
+
+void Archetypes::resetToDefaults() {
+    std::copy(DEFAULT_ENEMY_ARCHETYPES, DEFAULT_ENEMY_ARCHETYPES + ENEMY_TYPE_COUNT, enemies);
+    std::copy(DEFAULT_POWERUP_ARCHETYPES, DEFAULT_POWERUP_ARCHETYPES + POWERUP_TYPE_COUNT, powerUps);
+}
+
+bool Archetypes::loadTuning(const std::string& path) {
+    tuningPath = path;
+    resetToDefaults();
+    
+    std::error_code error;
+    tuningTime = std::filesystem::last_write_time(path, error);
+    std::ifstream file(path);
+    if (error || !file.is_open()) {
+        std::cout << "No tuning file found. Using built-in stats." << std::endl;
+        return false;
+    }
+    
+    std::string line;
+    int lineNumber = 0;
+    int applied = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        
+        // name.field = value
+        size_t dot = line.find('.');
+        size_t equals = line.find('=');
+        if (dot == std::string::npos || equals == std::string::npos || dot > equals) {
+            std::cout << path << ":" << lineNumber << ": expected name.field = value" << std::endl;
+            continue;
+        }
+        std::string name = trim(line.substr(0, dot));
+        std::string field = trim(line.substr(dot + 1, equals - dot - 1));
+        std::string value = trim(line.substr(equals + 1));
+        if (applyOverride(name, field, value)) {
+            applied++;
+        } else {
+            std::cout << path << ":" << lineNumber << ": unknown setting or bad value '" << line << "'" << std::endl;
+        }
+    }
+    
+    std::cout << "Loaded " << applied << " tuning overrides from " << path << std::endl;
+    return true;
+}
+
+bool Archetypes::reloadIfChanged() {
+    if (tuningPath.empty()) return false;
+    
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(tuningPath, error);
+    if (error || modified == tuningTime) return false;
+    
+    return loadTuning(tuningPath);
+}
+
+bool Archetypes::applyOverride(const std::string& name, const std::string& field, const std::string& value) {
+    // Numeric fields go through stof/stoi, which throw on garbage and on
+    // values out of their type's range
+    try {
+        for (size_t t = 0; t < ENEMY_TYPE_COUNT; t++) {
+            if (name != ENEMY_NAMES[t]) continue;
+            EnemyArchetype& archetype = enemies[t];
+            if (field == "health") archetype.health = std::clamp(std::stoi(value), 1, MAX_HEALTH);
+            else if (field == "attack") archetype.attack = std::stoi(value);
+            else if (field == "defense") archetype.defense = std::stoi(value);
+            else if (field == "speed") return parseFloat(value, 0.0f, MAX_SPEED, archetype.speed);
+            else if (field == "attack_range") return parseFloat(value, 0.0f, MAX_RANGE, archetype.attackRange);
+            else if (field == "detection_range") return parseFloat(value, 0.0f, MAX_RANGE, archetype.detectionRange);
+            else if (field == "attack_cooldown") return parseFloat(value, 0.0f, MAX_COOLDOWN, archetype.attackCooldown);
+            else if (field == "projectile_speed") return parseFloat(value, 0.0f, MAX_PROJECTILE_SPEED, archetype.projectileSpeed);
+            else if (field == "experience") archetype.experience = std::stoi(value);
+            else if (field == "color") return parseColor(value, archetype.red, archetype.green, archetype.blue);
+            else return false;
+            return true;
+        }
+        
+        for (size_t t = 0; t < POWERUP_TYPE_COUNT; t++) {
+            if (name != POWERUP_NAMES[t]) continue;
+            PowerUpArchetype& archetype = powerUps[t];
+            if (field == "value") archetype.effectValue = std::stoi(value);
+            else if (field == "duration") return parseFloat(value, 0.0f, MAX_DURATION, archetype.effectDuration);
+            else if (field == "color") return parseColor(value, archetype.red, archetype.green, archetype.blue);
+            else return false;
+            return true;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return false;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include "EnemyStore.h"
+#include "PowerUp.h"
+
+// Data shared by every instance of a type. Instances keep only their own
+// state (position, health, timers) and look the rest up here by type.
+struct EnemyArchetype {
+    int health;
+    int attack;
+    int defense;
+    float speed;
+    float attackRange;
+    float detectionRange;
+    float attackCooldown;
+    float projectileSpeed; // 0 for melee; ranged types fire a projectile instead
+    int experience;
+    std::uint8_t red, green, blue;
+};
+
+struct PowerUpArchetype {
+    int effectValue;
+    float effectDuration; // 0 for instant effects
+    std::uint8_t red, green, blue;
+};
+
+constexpr size_t ENEMY_TYPE_COUNT = 3;
+constexpr size_t POWERUP_TYPE_COUNT = 4;
+
+// Built-in tuning, indexed by EnemyType
+constexpr EnemyArchetype DEFAULT_ENEMY_ARCHETYPES[ENEMY_TYPE_COUNT] = {
+    // hp  atk def  speed  range   detect  cooldown  shot    xp   color
+    {  30,  8,  2,  80.0f,  35.0f, 100.0f, 1.5f,     0.0f,   25,  0, 255, 0 },     // Goblin: green
+    {  60, 15,  5,  60.0f,  40.0f, 120.0f, 2.0f,     0.0f,   50,  128, 64, 0 },    // Orc: brown
+    {  25, 12,  1, 100.0f, 150.0f, 190.0f, 1.6f,   260.0f,   35,  200, 200, 200 }  // Skeleton archer: light gray
+};
+
+// Indexed by PowerUpType
+constexpr PowerUpArchetype DEFAULT_POWERUP_ARCHETYPES[POWERUP_TYPE_COUNT] = {
+    { 30,  0.0f, 255, 0, 0 },   // Health potion: heal 30 HP, instant
+    { 15, 10.0f, 255, 255, 0 }, // Damage boost: +15 damage for 10 seconds
+    { 50,  8.0f, 0, 255, 0 },   // Speed boost: +50% speed for 8 seconds
+    {  5, 12.0f, 0, 0, 255 }    // Armor boost: +5 damage reduction for 12 seconds
+};
+
+// The active tables: the defaults above, with any overrides from a tuning
+// file applied. A tuning file holds lines like
+//
+//     orc.speed = 70
+//     skeleton.color = 220 220 255
+//     health_potion.value = 40
+//
+// with # starting a comment. Reloading changes live enemies and power-ups in
+// place, since they read their stats from here.
+class Archetypes {
+private:
+    static EnemyArchetype enemies[ENEMY_TYPE_COUNT];
+    static PowerUpArchetype powerUps[POWERUP_TYPE_COUNT];
+    static std::string tuningPath;
+    static std::filesystem::file_time_type tuningTime;
+    
+    static bool applyOverride(const std::string& name, const std::string& field, const std::string& value);
+    
+public:
+    static const EnemyArchetype& enemy(EnemyType type) { return enemies[static_cast<size_t>(type)]; }
+    static const PowerUpArchetype& powerUp(PowerUpType type) { return powerUps[static_cast<size_t>(type)]; }
+    static sf::Color color(EnemyType type);
+    static sf::Color color(PowerUpType type);
+    static const char* name(EnemyType type); // As in the tuning file
+    static const char* name(PowerUpType type);
+    static float maxDetectionRange();
+    static float maxAttackRange();
+    static std::uint64_t tableHash(); // Over the fields that affect play; colors are left out
+    
+    // Back to the defaults, then the file's overrides. A missing file just
+    // leaves the defaults; reloadIfChanged() picks it up once it appears.
+    static bool loadTuning(const std::string& path);
+    static bool reloadIfChanged();
+    static void resetToDefaults();
+};
@@ -0,0 +1,233 @@
+#include "BotInput.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+
+const std::uint32_t BotInput::REPLAN_INTERVAL = 15;
+const float BotInput::SWING_REACH = 50.0f;
+const float BotInput::THROW_RANGE = 250.0f;
+
+namespace {
+
+int tileAt(const Dungeon& dungeon, sf::Vector2f position) {
+    int x = std::clamp(static_cast<int>(position.x / Dungeon::TILE_SIZE), 0, dungeon.getWidth() - 1);
+    int y = std::clamp(static_cast<int>(position.y / Dungeon::TILE_SIZE), 0, dungeon.getHeight() - 1);
+    return y * dungeon.getWidth() + x;
+}
+
+sf::Vector2f tileCenter(const Dungeon& dungeon, int tile) {
+    return sf::Vector2f((tile % dungeon.getWidth() + 0.5f) * Dungeon::TILE_SIZE,
+                        (tile / dungeon.getWidth() + 0.5f) * Dungeon::TILE_SIZE);
+}
+
+} // namespace
+
+BotInput::BotInput(const Simulation& simulation)
+    : sim(simulation)
+    , plannedFloor(nullptr)
+    , plannedLevel(0)
+    , nextPlanTick(0)
+    , stuckTicks(0) {
+}
+
+InputCommand BotInput::sample(std::uint32_t tick) {
+    InputCommand command;
+    const Player* player = sim.getPlayer();
+    const Dungeon* dungeon = sim.getDungeon();
+    if (!player || !dungeon || !player->isAlive() || sim.getState() != GameState::PLAYING) {
+        return command;
+    }
+    
+    if (dungeon != plannedFloor || sim.getLevel() != plannedLevel) {
+        startFloor(*dungeon);
+    }
+    
+    sf::Vector2f position = player->getPosition();
+    int room = dungeon->getRoomAt(position.x, position.y);
+    if (room >= 0 && room < static_cast<int>(visitedRooms.size())) {
+        visitedRooms[room] = 1;
+    }
+    
+    // A move into a wall is undone whole, so standing still while walking
+    // means a corner caught the player
+    stuckTicks = position == lastPosition ? stuckTicks + 1 : 0;
+    lastPosition = position;
+    
+    if (tick >= nextPlanTick) {
+        plan(*dungeon, position);
+        nextPlanTick = tick + REPLAN_INTERVAL;
+    }
+    
+    // Waypoints are tile centers; one counts as reached within a step of it
+    int here = tileAt(*dungeon, position);
+    while (!path.empty() && path.back() == here) {
+        sf::Vector2f offset = tileCenter(*dungeon, here) - position;
+        if (std::abs(offset.x) > 3.0f || std::abs(offset.y) > 3.0f) break;
+        path.pop_back();
+    }
+    if (path.empty()) {
+        nextPlanTick = tick + 1; // Arrived; pick the next goal
+    }
+    
+    // Stuck: back to the middle of the current tile first, which lines the
+    // player up with the corridor, then on along the path
+    sf::Vector2f target = tileCenter(*dungeon, path.empty() ? here : path.back());
+    if (stuckTicks > 2) {
+        sf::Vector2f center = tileCenter(*dungeon, here);
+        if (std::abs(center.x - position.x) > 1.0f || std::abs(center.y - position.y) > 1.0f) {
+            target = center;
+        }
+    }
+    sf::Vector2f delta = target - position;
+    float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    sf::Vector2f aim = player->getFacing(); // Throws go the way this tick's move faces
+    if (length > 1.0f) {
+        aim = delta / length;
+        command.moveX = static_cast<std::int8_t>(std::lround(delta.x / length * InputCommand::AXIS_MAX));
+        command.moveY = static_cast<std::int8_t>(std::lround(delta.y / length * InputCommand::AXIS_MAX));
+    }
+    
+    // Swing at anything in reach, and at cracked walls in the way
+    bool swing = !path.empty() && dungeon->getTiles()[path.back()] == TileType::CRACKED_WALL;
+    const EnemyStore& enemies = sim.getEnemies();
+    enemies.queryRadius(position, SWING_REACH, nearby);
+    for (std::uint32_t i : nearby) {
+        if (!enemies.isDead(i)) {
+            swing = true;
+            break;
+        }
+    }
+    if (swing) {
+        command.buttons |= BUTTON_ATTACK;
+    } else if (enemyInLine(position, aim, *dungeon)) {
+        command.buttons |= BUTTON_THROW;
+    }
+    return command;
+}
+
+void BotInput::startFloor(const Dungeon& dungeon) {
+    size_t tiles = static_cast<size_t>(dungeon.getWidth()) * dungeon.getHeight();
+    cameFrom.assign(tiles, -1);
+    goals.assign(tiles, 0);
+    frontier.reserve(tiles);
+    path.reserve(tiles);
+    visitedRooms.assign(dungeon.getRoomCount(), 0);
+    path.clear();
+    plannedFloor = &dungeon;
+    plannedLevel = sim.getLevel();
+    nextPlanTick = 0;
+}
+
+void BotInput::plan(const Dungeon& dungeon, sf::Vector2f position) {
+    int start = tileAt(dungeon, position);
+    if (markItemGoals(dungeon) && search(dungeon, start)) return;
+    if (markRoomGoals(dungeon) && search(dungeon, start)) return;
+    
+    // Every reachable room has been seen: go round again, since enemies
+    // wander and wake up
+    std::fill(visitedRooms.begin(), visitedRooms.end(), 0);
+    path.clear();
+}
+
+bool BotInput::search(const Dungeon& dungeon, int start) {
+    // Four-way, so every step is along a corridor and never cuts a corner.
+    // Cracked walls count as open; the player swings through them.
+    const int width = dungeon.getWidth();
+    const int height = dungeon.getHeight();
+    const auto& tiles = dungeon.getTiles();
+    std::fill(cameFrom.begin(), cameFrom.end(), -1);
+    frontier.clear();
+    frontier.push_back(start);
+    cameFrom[start] = start;
+    
+    for (size_t next = 0; next < frontier.size(); next++) {
+        int tile = frontier[next];
+        if (goals[tile]) {
+            path.clear();
+            for (int step = tile; step != start; step = cameFrom[step]) {
+                path.push_back(step);
+            }
+            return true;
+        }
+        
+        int x = tile % width;
+        int y = tile / width;
+        const int neighbors[4] = {
+            x > 0 ? tile - 1 : -1,
+            x < width - 1 ? tile + 1 : -1,
+            y > 0 ? tile - width : -1,
+            y < height - 1 ? tile + width : -1
+        };
+        for (int neighbor : neighbors) {
+            if (neighbor < 0 || cameFrom[neighbor] >= 0 || tiles[neighbor] == TileType::WALL) continue;
+            cameFrom[neighbor] = tile;
+            frontier.push_back(neighbor);
+        }
+    }
+    return false;
+}
+
+bool BotInput::markItemGoals(const Dungeon& dungeon) {
+    std::fill(goals.begin(), goals.end(), 0);
+    bool any = false;
+    for (int tile : dungeon.getTreasureTiles()) {
+        goals[tile] = 1;
+        any = true;
+    }
+    
+    const Pool<PowerUp>& powerUps = sim.getPowerUps();
+    for (std::uint32_t slot : powerUps.liveSlots()) {
+        markGoal(dungeon, powerUps[slot].getPosition());
+        any = true;
+    }
+    
+    const EnemyStore& enemies = sim.getEnemies();
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (enemies.isDead(i)) continue;
+        markGoal(dungeon, enemies.getPosition(i));
+        any = true;
+    }
+    return any;
+}
+
+bool BotInput::markRoomGoals(const Dungeon& dungeon) {
+    std::fill(goals.begin(), goals.end(), 0);
+    bool any = false;
+    for (int room = 0; room < dungeon.getRoomCount(); room++) {
+        if (visitedRooms[room]) continue;
+        
+        // Any open tile will do; shaped rooms can have walls at the center
+        sf::FloatRect bounds = dungeon.getRoomBounds(room);
+        for (float y = bounds.top + Dungeon::TILE_SIZE / 2; y < bounds.top + bounds.height; y += Dungeon::TILE_SIZE) {
+            for (float x = bounds.left + Dungeon::TILE_SIZE / 2; x < bounds.left + bounds.width; x += Dungeon::TILE_SIZE) {
+                if (!Dungeon::isBlocking(dungeon.getTileType(x, y))) {
+                    markGoal(dungeon, sf::Vector2f(x, y));
+                    any = true;
+                }
+            }
+        }
+    }
+    return any;
+}
+
+void BotInput::markGoal(const Dungeon& dungeon, sf::Vector2f position) {
+    goals[tileAt(dungeon, position)] = 1;
+}
+
+bool BotInput::enemyInLine(sf::Vector2f position, sf::Vector2f facing, const Dungeon& dungeon) {
+    const EnemyStore& enemies = sim.getEnemies();
+    enemies.queryRadius(position, THROW_RANGE, nearby);
+    for (std::uint32_t i : nearby) {
+        if (enemies.isDead(i)) continue;
+        sf::Vector2f toEnemy = enemies.getPosition(i) - position;
+        float distance = std::sqrt(toEnemy.x * toEnemy.x + toEnemy.y * toEnemy.y);
+        if (distance < 1.0f) continue;
+        
+        // Within about ten degrees of where the throw would go, with a clear line
+        if ((toEnemy.x * facing.x + toEnemy.y * facing.y) / distance > 0.985f &&
+            dungeon.sweep(position, enemies.getPosition(i)) >= 1.0f) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "InputSource.h"
+
+class Dungeon;
+class Simulation;
+
+// Plays the game from what the simulation exposes, for soak and load tests.
+// Walks the tile grid to the nearest treasure, power-up or live enemy,
+// swinging at whatever is in reach and throwing at enemies in line; with
+// nothing left in sight it explores the rooms it hasn't entered yet, which
+// wakes their dormant enemies. It reads the simulation only on the thread
+// that ticks it, and depends on nothing but its state, so a seed plays the
+// same every time.
+class BotInput : public InputSource {
+private:
+    const Simulation& sim;
+    
+    // Breadth-first search over tiles, kept between plans
+    std::vector<std::int32_t> cameFrom; // -1 unreached
+    std::vector<std::uint8_t> goals;
+    std::vector<std::int32_t> frontier;
+    std::vector<std::int32_t> path;     // Tiles still to walk; the next one is last
+    std::vector<std::uint8_t> visitedRooms;
+    std::vector<std::uint32_t> nearby;  // Scratch for enemy queries
+    
+    const Dungeon* plannedFloor; // A new floor starts the room log over
+    int plannedLevel;
+    std::uint32_t nextPlanTick;
+    sf::Vector2f lastPosition;
+    int stuckTicks;
+    
+    void startFloor(const Dungeon& dungeon);
+    void plan(const Dungeon& dungeon, sf::Vector2f position);
+    bool search(const Dungeon& dungeon, int start); // False if no goal is reachable
+    bool markItemGoals(const Dungeon& dungeon);
+    bool markRoomGoals(const Dungeon& dungeon);
+    void markGoal(const Dungeon& dungeon, sf::Vector2f position);
+    bool enemyInLine(sf::Vector2f position, sf::Vector2f facing, const Dungeon& dungeon);
+
+public:
+    explicit BotInput(const Simulation& simulation);
+    
+    InputCommand sample(std::uint32_t tick) override;
+    
+    static const std::uint32_t REPLAN_INTERVAL; // Ticks between searches; enemies move
+    static const float SWING_REACH;             // Inside the player's attack radius
+    static const float THROW_RANGE;
+};
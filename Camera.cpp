@@ -1,6 +1,5 @@
 #include "Camera.h"
 #include <cmath>
-#include <random>
 
 Camera::Camera(float width, float height) 
     : smoothness(5.0f)
@@ -10,32 +9,33 @@ Camera::Camera(float width, float height)
     , shakeOffset(0, 0) {
     
     view.setSize(width, height);
-    view.setCenter(width / 2, height / 2);
-    targetPosition = view.getCenter();
+    center = sf::Vector2f(width / 2, height / 2);
+    previousCenter = center;
+    view.setCenter(center);
+    targetPosition = center;
 }
 
 void Camera::update(sf::Vector2f playerPosition, float deltaTime) {
     // Update target position to player position
     targetPosition = playerPosition;
     
-    // Smooth camera movement
-    sf::Vector2f currentCenter = view.getCenter();
-    sf::Vector2f direction = targetPosition - currentCenter;
+    // Smooth camera movement. Shake is added on top afterwards, so it never
+    // feeds back into where the camera goes next.
+    previousCenter = center;
+    sf::Vector2f direction = targetPosition - center;
     
     // Apply smoothing
-    sf::Vector2f newCenter = currentCenter + direction * smoothness * deltaTime;
+    center += direction * smoothness * deltaTime;
     
     // Update shake effect
     if (shakeTimer > 0) {
         shakeTimer -= deltaTime;
         
         // Generate random shake offset
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_real_distribution<float> shakeDist(-shakeIntensity, shakeIntensity);
         
-        shakeOffset.x = shakeDist(gen);
-        shakeOffset.y = shakeDist(gen);
+        shakeOffset.x = shakeDist(shakeRng);
+        shakeOffset.y = shakeDist(shakeRng);
         
         // Reduce shake intensity over time
         float shakeProgress = shakeTimer / shakeDuration;
@@ -46,7 +46,13 @@ void Camera::update(sf::Vector2f playerPosition, float deltaTime) {
     }
     
     // Apply final position with shake
-    view.setCenter(newCenter + shakeOffset);
+    view.setCenter(center + shakeOffset);
+}
+
+sf::View Camera::getView(float alpha) const {
+    sf::View blended = view;
+    blended.setCenter(previousCenter + (center - previousCenter) * alpha + shakeOffset);
+    return blended;
 }
 
 void Camera::setTarget(sf::Vector2f target) {
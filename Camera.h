@@ -1,9 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <random>
 
 class Camera {
 private:
     sf::View view;
+    sf::Vector2f center; // Followed position, without shake
+    sf::Vector2f previousCenter; // Before the last update, for render interpolation
     sf::Vector2f targetPosition;
     float smoothness;
     
@@ -13,6 +16,8 @@ public:
     void update(sf::Vector2f playerPosition, float deltaTime);
     void setTarget(sf::Vector2f target);
     sf::View getView() const { return view; }
+    sf::View getView(float alpha) const; // Blended from the previous update's center (0) to the current one (1)
+    sf::Vector2f getCenter() const { return center; } // Unaffected by shake; safe for simulation use
     void setView(sf::RenderWindow& window);
     void shake(float intensity, float duration);
     
@@ -22,4 +27,5 @@ private:
     float shakeDuration;
     float shakeTimer;
     sf::Vector2f shakeOffset;
+    std::minstd_rand shakeRng;
 };
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Combat.h"
+#include "EnemyStore.h"
+#include "Archetypes.h"
+#include "Player.h"
+#include "ProjectileStore.h"
+#include <algorithm>
+#include <cmath>
+
+const std::uint32_t CombatSystem::PLAYER_TARGET = 0xFFFFFFFFu;
+
+void CombatSystem::playerAttack(EnemyStore& enemies, sf::Vector2f center, float radius, int damage, std::uint32_t attackId) {
+    enemies.queryRadius(center, radius, nearby);
+    for (std::uint32_t i : nearby) {
+        if (enemies.isDead(i) || !enemies.markHit(i, attackId)) continue;
+        events.push_back(HitEvent{ i, damage });
+    }
+}
+
+void CombatSystem::enemyAttacks(EnemyStore& enemies, ProjectileStore& projectiles, sf::Vector2f playerPos, float reach) {
+    enemies.queryRadius(playerPos, reach, nearby);
+    for (std::uint32_t i : nearby) {
+        int damage = enemies.strike(i);
+        if (damage <= 0) continue;
+        
+        float speed = Archetypes::enemy(enemies.getType(i)).projectileSpeed;
+        if (speed <= 0.0f) {
+            events.push_back(HitEvent{ PLAYER_TARGET, damage });
+            continue;
+        }
+        
+        // Aim where the player stands now
+        sf::Vector2f from = enemies.getPosition(i);
+        sf::Vector2f offset = playerPos - from;
+        float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+        if (distance <= 0.0f) {
+            events.push_back(HitEvent{ PLAYER_TARGET, damage });
+            continue;
+        }
+        projectiles.spawn(ProjectileOwner::ENEMY, from, offset * (speed / distance), damage);
+    }
+}
+
+void CombatSystem::projectileHits(ProjectileStore& projectiles, EnemyStore& enemies, sf::Vector2f playerPos, float playerRadius) {
+    const float playerReach = ProjectileStore::RADIUS + playerRadius;
+    const float enemyReach = ProjectileStore::RADIUS + EnemyStore::ENEMY_SIZE / 2;
+    
+    // Back to front, so removing a spent projectile only moves one already tested
+    for (size_t p = projectiles.size(); p-- > 0;) {
+        sf::Vector2f position = projectiles.getPosition(p);
+        
+        if (projectiles.getOwner(p) == ProjectileOwner::ENEMY) {
+            float dx = position.x - playerPos.x;
+            float dy = position.y - playerPos.y;
+            if (dx * dx + dy * dy <= playerReach * playerReach) {
+                events.push_back(HitEvent{ PLAYER_TARGET, projectiles.getDamage(p) });
+                projectiles.remove(p);
+            }
+            continue;
+        }
+        
+        if (enemies.empty()) continue;
+        enemies.queryRadius(position, enemyReach, nearby);
+        
+        // Lowest index among the candidates, so the pick doesn't depend on grid order
+        std::uint32_t target = PLAYER_TARGET;
+        for (std::uint32_t i : nearby) {
+            if (!enemies.isDead(i)) target = std::min(target, i);
+        }
+        if (target != PLAYER_TARGET) {
+            events.push_back(HitEvent{ target, projectiles.getDamage(p) });
+            projectiles.remove(p);
+        }
+    }
+}
+
+CombatReport CombatSystem::resolve(EnemyStore& enemies, Player& player) {
+    CombatReport report;
+    
+    // PLAYER_TARGET sorts first; ties keep emission order
+    std::stable_sort(events.begin(), events.end(), [](const HitEvent& a, const HitEvent& b) {
+        return a.target > b.target;
+    });
+    
+    size_t e = 0;
+    while (e < events.size()) {
+        std::uint32_t target = events[e].target;
+        
+        if (target == PLAYER_TARGET) {
+            report.damageTaken += player.takeDamage(events[e].damage);
+            report.playerHits++;
+            e++;
+            continue;
+        }
+        
+        // All of this enemy's hits, then one death check
+        for (; e < events.size() && events[e].target == target; e++) {
+            if (enemies.isDead(target)) continue;
+            report.damageDealt += enemies.takeDamage(target, events[e].damage);
+            report.enemyHits++;
+        }
+        if (enemies.isDead(target)) {
+            report.kills++;
+            report.experience += enemies.getExperienceReward(target);
+            enemies.remove(target);
+        }
+    }
+    
+    events.clear();
+    return report;
+}
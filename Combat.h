@@ -0,0 +1,62 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class EnemyStore;
+class Player;
+class ProjectileStore;
+
+// One landed attack, waiting to be applied
+struct HitEvent {
+    std::uint32_t target; // Enemy index, or PLAYER_TARGET
+    int damage;           // Before armor or defense
+};
+
+// What a tick of combat added up to. The caller turns this into score,
+// experience, screen shake and one log line instead of doing so per hit.
+struct CombatReport {
+    int enemyHits = 0;
+    int damageDealt = 0;
+    int kills = 0;
+    int experience = 0;
+    int playerHits = 0;
+    int damageTaken = 0;
+    
+    bool empty() const { return enemyHits == 0 && playerHits == 0; }
+};
+
+// Attacks emit hit events during the tick; resolve() applies them all in one
+// pass. Events are applied in a fixed order (player first, then enemies from
+// the highest index down), so the result never depends on emission order and
+// killed enemies can be swap-removed as they are reached.
+class CombatSystem {
+private:
+    std::vector<HitEvent> events;
+    std::vector<std::uint32_t> nearby; // Scratch for spatial queries
+
+public:
+    // Player swing: every live enemy within the radius not yet hit by this attack
+    void playerAttack(EnemyStore& enemies, sf::Vector2f center, float radius, int damage, std::uint32_t attackId);
+    
+    // Enemies near the player whose attacks are ready. Melee attacks land
+    // straight away; ranged ones launch a projectile at the player.
+    void enemyAttacks(EnemyStore& enemies, ProjectileStore& projectiles, sf::Vector2f playerPos, float reach);
+    
+    // Projectiles touching their target: the player for enemy shots, and the
+    // first live enemy from the enemy grid for the player's. A projectile
+    // that hits is spent.
+    void projectileHits(ProjectileStore& projectiles, EnemyStore& enemies, sf::Vector2f playerPos, float playerRadius);
+    
+    CombatReport resolve(EnemyStore& enemies, Player& player);
+    void clear() { events.clear(); }
+    
+    size_t pending() const { return events.size(); }
+    
+    // Damage a hit does after the target's armor or defense; never below 1.
+    // The one formula for both sides, also used by the balance tool.
+    static int mitigate(int damage, int armor) { return std::max(1, damage - armor); }
+    
+    static const std::uint32_t PLAYER_TARGET;
+};
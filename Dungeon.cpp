@@ -5,28 +5,88 @@
 #include <cmath>
 
 Dungeon::Dungeon(int w, int h) 
-    : width(w), height(h), rng(std::random_device{}()) {
+    : arena(estimateLevelBytes(w, h)), generated(false), tiles(&arena), rooms(&arena)
+    , width(w), height(h), stairsDown(0, 0), seed(0), rng(std::random_device{}()), currentTick(0)
+    , wallBits(&arena), treasureTiles(&arena), chunkVertices(&arena), chunkDirty(&arena)
+    , regionLabels(&arena), regionRoots(&arena), regionMarks(&arena), regionQueue(&arena), relabelledChunks(&arena)
+    , regionStamp(0), navDistance(&arena), navFrontier(&arena), navValid(false)
+    , fovVisible(&arena), fovValid(false) {
+    
+    // Render chunks cover the grid in CHUNK_SIZE x CHUNK_SIZE blocks
+    chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    
+    resetLevelStorage();
+}
+
+size_t Dungeon::estimateLevelBytes(int w, int h) {
+    // Per tile: the tile, its region label and a wall bit; per chunk, a
+    // root and a walk stamp for each possible label, queue room for the
+    // most labels a chunk can hold, and its index; plus the fixed navigation
+    // and FOV windows and some slack for rooms and treasures
+    size_t tileCount = static_cast<size_t>(w) * h;
+    size_t labelSlots = static_cast<size_t>((w + CHUNK_SIZE - 1) / CHUNK_SIZE) * ((h + CHUNK_SIZE - 1) / CHUNK_SIZE)
+                      * CHUNK_SIZE * CHUNK_SIZE;
+    size_t navTiles = (2 * NAV_RADIUS + 1) * (2 * NAV_RADIUS + 1);
+    size_t fovTiles = (2 * FOV_RADIUS + 1) * (2 * FOV_RADIUS + 1);
+    return tileCount * (sizeof(TileType) + sizeof(std::uint32_t)) + tileCount / 8
+         + labelSlots * 2 * sizeof(std::uint32_t) + labelSlots / 2 * sizeof(std::uint32_t)
+         + labelSlots / (CHUNK_SIZE * CHUNK_SIZE) * sizeof(int)
+         + navTiles * (sizeof(std::uint16_t) + sizeof(int)) + fovTiles
+         + 16 * 1024;
+}
+
+void Dungeon::resetLevelStorage() {
+    // Drop every container, then hand the arena's blocks back in one go
+    tiles = std::pmr::vector<TileType>(&arena);
+    rooms = std::pmr::vector<Room>(&arena);
+    wallBits = std::pmr::vector<std::uint64_t>(&arena);
+    treasureTiles = std::pmr::vector<int>(&arena);
+    chunkVertices = std::pmr::vector<sf::VertexArray>(&arena);
+    chunkDirty = std::pmr::vector<std::uint8_t>(&arena);
+    regionLabels = std::pmr::vector<std::uint32_t>(&arena);
+    regionRoots = std::pmr::vector<std::uint32_t>(&arena);
+    regionMarks = std::pmr::vector<std::uint32_t>(&arena);
+    regionQueue = std::pmr::vector<std::uint32_t>(&arena);
+    relabelledChunks = std::pmr::vector<int>(&arena);
+    navDistance = std::pmr::vector<std::uint16_t>(&arena);
+    navFrontier = std::pmr::vector<int>(&arena);
+    fovVisible = std::pmr::vector<std::uint8_t>(&arena);
+    arena.reset();
+    navValid = false;
+    fovValid = false;
     
     // Initialize the tile grid
-    tiles.resize(height);
-    for (int y = 0; y < height; y++) {
-        tiles[y].reserve(width);
-        for (int x = 0; x < width; x++) {
-            tiles[y].emplace_back(TileType::WALL, x * TILE_SIZE, y * TILE_SIZE, x, y);
-        }
-    }
+    tiles.assign(width * height, TileType::WALL);
+    regionLabels.assign(width * height, 0);
+    regionRoots.assign(chunksX * chunksY * CHUNK_SIZE * CHUNK_SIZE, 0);
+    regionMarks.assign(regionRoots.size(), 0);
+    regionStamp = 0;
+    regionQueue.reserve(regionRoots.size() / 2);
+    relabelledChunks.reserve(chunksX * chunksY);
+    navDistance.assign((2 * NAV_RADIUS + 1) * (2 * NAV_RADIUS + 1), 0xFFFF);
+    fovVisible.assign((2 * FOV_RADIUS + 1) * (2 * FOV_RADIUS + 1), 0);
+    navFrontier.reserve(navDistance.size());
+    chunkVertices.resize(chunksX * chunksY, sf::VertexArray(sf::Quads));
+    
+    rebuildCaches();
 }
 
 void Dungeon::generate() {
-    // Clear previous generation
-    rooms.clear();
+    generate(rng(), false);
+}
+
+void Dungeon::generate(unsigned int levelSeed, bool withStairsUp) {
+    // Same seed always produces the same layout
+    seed = levelSeed;
+    rng.seed(seed);
     
-    // Fill with walls initially
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            setTile(x, y, TileType::WALL);
-        }
+    // Clear previous generation; a fresh Dungeon is already all walls
+    if (generated) {
+        resetLevelStorage();
     }
+    generated = true;
+    journal.clear();
     
     // Generate rooms
     generateRooms();
@@ -37,12 +97,165 @@ void Dungeon::generate() {
     // Place treasures
     placeTreasures();
     
+    // Some walls can be broken through
+    placeCrackedWalls();
+    
     // Set player spawn point (first room center)
     if (!rooms.empty()) {
         playerSpawn = sf::Vector2i(rooms[0].center.x * TILE_SIZE + TILE_SIZE/2, 
                                   rooms[0].center.y * TILE_SIZE + TILE_SIZE/2);
         setTile(rooms[0].center.x, rooms[0].center.y, TileType::SPAWN);
     }
+    
+    // Stairs connecting to the floors above and below
+    placeStairs(withStairsUp);
+    
+    // Derived caches are built once here and then patched per mutation
+    rebuildCaches();
+}
+
+void Dungeon::placeStairs(bool withStairsUp) {
+    if (rooms.empty()) return;
+    
+    // Arriving from above puts the player on the up stairs
+    if (withStairsUp) {
+        setTile(rooms[0].center.x, rooms[0].center.y, TileType::STAIRS_UP);
+    }
+    
+    // Down stairs go in the room farthest from the spawn
+    size_t farthestRoom = 0;
+    int farthestDistance = -1;
+    for (size_t i = 1; i < rooms.size(); i++) {
+        int dx = rooms[i].center.x - rooms[0].center.x;
+        int dy = rooms[i].center.y - rooms[0].center.y;
+        if (dx * dx + dy * dy > farthestDistance) {
+            farthestDistance = dx * dx + dy * dy;
+            farthestRoom = i;
+        }
+    }
+    
+    if (farthestRoom != 0) {
+        stairsDown = rooms[farthestRoom].center;
+        setTile(stairsDown.x, stairsDown.y, TileType::STAIRS_DOWN);
+    }
+}
+
+void Dungeon::replay(const TileJournal& savedJournal) {
+    for (size_t i = 0; i < savedJournal.size(); i++) {
+        const TileMutation& mutation = savedJournal[i];
+        if (mutation.index >= tiles.size() || !isTileType(mutation.newType)) continue;
+        
+        if (static_cast<std::uint8_t>(tiles[mutation.index]) != mutation.oldType) {
+            std::cout << "Warning: journal entry " << i << " does not match the regenerated level" << std::endl;
+        }
+        
+        tiles[mutation.index] = static_cast<TileType>(mutation.newType);
+        applyMutation(mutation);
+    }
+    journal = savedJournal;
+}
+
+size_t Dungeon::getMemoryUsage() const {
+    // Everything in the arena, plus what lives outside it: the journal
+    // (kept across eviction) and the chunks' own vertex buffers
+    size_t bytes = sizeof(Dungeon);
+    bytes += arena.getBytesUsed();
+    bytes += journal.getMemoryUsage();
+    for (const auto& chunk : chunkVertices) {
+        bytes += chunk.getVertexCount() * sizeof(sf::Vertex);
+    }
+    return bytes;
+}
+
+void Dungeon::rebuildCaches() {
+    // Collision bitset, one bit per tile
+    wallBits.assign((tiles.size() + 63) / 64, 0);
+    treasureTiles.clear();
+    
+    for (size_t i = 0; i < tiles.size(); i++) {
+        if (isBlocking(tiles[i])) {
+            wallBits[i / 64] |= std::uint64_t(1) << (i % 64);
+        } else if (tiles[i] == TileType::TREASURE) {
+            treasureTiles.push_back(i);
+        }
+    }
+    
+    // Every chunk needs every layer rebuilt
+    chunkDirty.assign(chunkVertices.size(), DIRTY_ALL);
+    navValid = false;
+    fovValid = false;
+}
+
+void Dungeon::applyMutation(const TileMutation& mutation) {
+    int index = mutation.index;
+    TileType oldType = static_cast<TileType>(mutation.oldType);
+    TileType newType = static_cast<TileType>(mutation.newType);
+    
+    // Collision bitset
+    std::uint64_t bit = std::uint64_t(1) << (index % 64);
+    if (isBlocking(newType)) {
+        wallBits[index / 64] |= bit;
+    } else {
+        wallBits[index / 64] &= ~bit;
+    }
+    
+    // Treasure index
+    if (oldType == TileType::TREASURE && newType != TileType::TREASURE) {
+        auto it = std::find(treasureTiles.begin(), treasureTiles.end(), index);
+        if (it != treasureTiles.end()) {
+            *it = treasureTiles.back();
+            treasureTiles.pop_back();
+        }
+    } else if (newType == TileType::TREASURE && oldType != TileType::TREASURE) {
+        treasureTiles.push_back(index);
+    }
+    
+    // Everything else is rebuilt lazily, per chunk, by whoever reads it next
+    int chunkX = (index % width) / CHUNK_SIZE;
+    int chunkY = (index / width) / CHUNK_SIZE;
+    chunkDirty[chunkY * chunksX + chunkX] |= DIRTY_ALL;
+}
+
+void Dungeon::rebuildChunk(int chunkX, int chunkY) {
+    buildChunkVertices(tiles.data(), width, height, chunkX, chunkY, chunkVertices[chunkY * chunksX + chunkX]);
+    chunkDirty[chunkY * chunksX + chunkX] &= ~DIRTY_RENDER;
+}
+
+void Dungeon::buildChunkVertices(const TileType* grid, int gridWidth, int gridHeight, int chunkX, int chunkY,
+                                 sf::VertexArray& vertices) {
+    vertices.clear();
+    
+    int startX = chunkX * CHUNK_SIZE;
+    int startY = chunkY * CHUNK_SIZE;
+    int endX = std::min(gridWidth, startX + CHUNK_SIZE);
+    int endY = std::min(gridHeight, startY + CHUNK_SIZE);
+    
+    // One quad per tile, drawn with a single call per chunk
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            sf::Color color = getTileColor(grid[y * gridWidth + x]);
+            float left = x * TILE_SIZE;
+            float top = y * TILE_SIZE;
+            vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+            vertices.append(sf::Vertex(sf::Vector2f(left + TILE_SIZE, top), color));
+            vertices.append(sf::Vertex(sf::Vector2f(left + TILE_SIZE, top + TILE_SIZE), color));
+            vertices.append(sf::Vertex(sf::Vector2f(left, top + TILE_SIZE), color));
+        }
+    }
+}
+
+sf::Color Dungeon::getTileColor(TileType type) {
+    switch (type) {
+        case TileType::WALL: return sf::Color(100, 100, 100);
+        case TileType::FLOOR: return sf::Color(200, 200, 200);
+        case TileType::DOOR: return sf::Color(139, 69, 19);
+        case TileType::TREASURE: return sf::Color::Yellow;
+        case TileType::SPAWN: return sf::Color::Green;
+        case TileType::STAIRS_DOWN: return sf::Color(75, 0, 130);
+        case TileType::STAIRS_UP: return sf::Color(186, 140, 255);
+        case TileType::CRACKED_WALL: return sf::Color(130, 110, 90);
+    }
+    return sf::Color::Magenta;
 }
 
 void Dungeon::generateRooms() {
@@ -119,7 +332,7 @@ void Dungeon::generateCorridors() {
     if (rooms.empty()) return;
     
     // Create a minimum spanning tree for room connections
-    std::vector<bool> connected(rooms.size(), false);
+    std::pmr::vector<bool> connected(rooms.size(), false, &arena);
     connected[0] = true; // Start with first room
     
     // Connect all rooms with minimum spanning tree approach
@@ -388,7 +601,7 @@ void Dungeon::placeTreasures() {
 
 void Dungeon::setTile(int x, int y, TileType type) {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        tiles[y][x] = Tile(type, x * TILE_SIZE, y * TILE_SIZE, x, y);
+        tiles[y * width + x] = type;
     }
 }
 
@@ -400,15 +613,35 @@ void Dungeon::render(sf::RenderWindow& window, const sf::View& view) {
     viewBounds.width = view.getSize().x;
     viewBounds.height = view.getSize().y;
     
-    // Calculate tile range to render
-    int startX = std::max(0, static_cast<int>(viewBounds.left / TILE_SIZE) - 1);
-    int endX = std::min(width, static_cast<int>((viewBounds.left + viewBounds.width) / TILE_SIZE) + 2);
-    int startY = std::max(0, static_cast<int>(viewBounds.top / TILE_SIZE) - 1);
-    int endY = std::min(height, static_cast<int>((viewBounds.top + viewBounds.height) / TILE_SIZE) + 2);
+    refreshChunks(viewBounds);
+    
+    // Calculate chunk range to render
+    const float chunkPixels = CHUNK_SIZE * TILE_SIZE;
+    int startX = std::max(0, static_cast<int>(std::floor(viewBounds.left / chunkPixels)));
+    int endX = std::min(chunksX, static_cast<int>(std::floor((viewBounds.left + viewBounds.width) / chunkPixels)) + 1);
+    int startY = std::max(0, static_cast<int>(std::floor(viewBounds.top / chunkPixels)));
+    int endY = std::min(chunksY, static_cast<int>(std::floor((viewBounds.top + viewBounds.height) / chunkPixels)) + 1);
+    
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            window.draw(chunkVertices[y * chunksX + x]);
+        }
+    }
+}
+
+void Dungeon::refreshChunks(const sf::FloatRect& area) {
+    const float chunkPixels = CHUNK_SIZE * TILE_SIZE;
+    int startX = std::max(0, static_cast<int>(std::floor(area.left / chunkPixels)));
+    int endX = std::min(chunksX, static_cast<int>(std::floor((area.left + area.width) / chunkPixels)) + 1);
+    int startY = std::max(0, static_cast<int>(std::floor(area.top / chunkPixels)));
+    int endY = std::min(chunksY, static_cast<int>(std::floor((area.top + area.height) / chunkPixels)) + 1);
     
+    // Chunks touched by tile mutations are rebuilt on demand
     for (int y = startY; y < endY; y++) {
         for (int x = startX; x < endX; x++) {
-            window.draw(tiles[y][x].shape);
+            if (chunkDirty[y * chunksX + x] & DIRTY_RENDER) {
+                rebuildChunk(x, y);
+            }
         }
     }
 }
@@ -421,13 +654,51 @@ bool Dungeon::isWall(float x, float y) const {
         return true; // Out of bounds is considered a wall
     }
     
-    return tiles[gridY][gridX].type == TileType::WALL;
+    int index = gridY * width + gridX;
+    return (wallBits[index / 64] >> (index % 64)) & 1;
 }
 
 bool Dungeon::isValidPosition(float x, float y) const {
     return !isWall(x, y);
 }
 
+float Dungeon::sweep(sf::Vector2f from, sf::Vector2f to) const {
+    int x = static_cast<int>(std::floor(from.x / TILE_SIZE));
+    int y = static_cast<int>(std::floor(from.y / TILE_SIZE));
+    if (isBlockingTile(x, y)) return 0.0f;
+    
+    int endX = static_cast<int>(std::floor(to.x / TILE_SIZE));
+    int endY = static_cast<int>(std::floor(to.y / TILE_SIZE));
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    const float never = std::numeric_limits<float>::infinity();
+    
+    // Grid traversal: step into whichever neighbouring tile the segment
+    // reaches first, tracking the segment parameter at each boundary
+    int stepX = dx > 0 ? 1 : -1;
+    int stepY = dy > 0 ? 1 : -1;
+    float deltaX = dx != 0 ? TILE_SIZE / std::abs(dx) : never;
+    float deltaY = dy != 0 ? TILE_SIZE / std::abs(dy) : never;
+    float nextX = dx > 0 ? ((x + 1) * TILE_SIZE - from.x) / dx : dx < 0 ? (x * TILE_SIZE - from.x) / dx : never;
+    float nextY = dy > 0 ? ((y + 1) * TILE_SIZE - from.y) / dy : dy < 0 ? (y * TILE_SIZE - from.y) / dy : never;
+    
+    while (x != endX || y != endY) {
+        float t;
+        if (nextX < nextY) {
+            t = nextX;
+            x += stepX;
+            nextX += deltaX;
+        } else {
+            t = nextY;
+            y += stepY;
+            nextY += deltaY;
+        }
+        if (t > 1.0f) break; // Rounding walked past the end tile
+        if (isBlockingTile(x, y)) return t;
+    }
+    return 1.0f;
+}
+
 TileType Dungeon::getTileType(float x, float y) const {
     int gridX = static_cast<int>(x / TILE_SIZE);
     int gridY = static_cast<int>(y / TILE_SIZE);
@@ -436,16 +707,39 @@ TileType Dungeon::getTileType(float x, float y) const {
         return TileType::WALL;
     }
     
-    return tiles[gridY][gridX].type;
+    return tiles[gridY * width + gridX];
 }
 
 sf::Vector2f Dungeon::getPlayerSpawn() const {
     return sf::Vector2f(playerSpawn.x, playerSpawn.y);
 }
 
-std::vector<sf::Vector2f> Dungeon::getEnemySpawns(int count) const {
-    std::vector<sf::Vector2f> spawns;
-    std::mt19937 localRng(std::random_device{}());
+sf::Vector2f Dungeon::getStairsDown() const {
+    return sf::Vector2f(stairsDown.x * TILE_SIZE + TILE_SIZE / 2, stairsDown.y * TILE_SIZE + TILE_SIZE / 2);
+}
+
+int Dungeon::getRoomAt(float x, float y) const {
+    int gridX = static_cast<int>(x / TILE_SIZE);
+    int gridY = static_cast<int>(y / TILE_SIZE);
+    
+    for (size_t i = 0; i < rooms.size(); i++) {
+        const Room& room = rooms[i];
+        if (gridX >= room.x && gridX < room.x + room.width &&
+            gridY >= room.y && gridY < room.y + room.height) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+sf::FloatRect Dungeon::getRoomBounds(int room) const {
+    const Room& r = rooms[room];
+    return sf::FloatRect(r.x * TILE_SIZE, r.y * TILE_SIZE, r.width * TILE_SIZE, r.height * TILE_SIZE);
+}
+
+std::pmr::vector<sf::Vector2f> Dungeon::getEnemySpawns(int count) {
+    std::pmr::vector<sf::Vector2f> spawns(&arena);
+    std::mt19937 localRng(seed ^ 0x9E3779B9u); // Derived from the level seed so revisits match
     std::uniform_int_distribution<int> roomDist(1, rooms.size() - 1); // Skip first room (player spawn)
     
     for (int i = 0; i < count && rooms.size() > 1; i++) {
@@ -470,6 +764,331 @@ void Dungeon::setTileTypeAt(float x, float y, TileType type) {
     int gridY = static_cast<int>(y / TILE_SIZE);
     
     if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-        setTile(gridX, gridY, type);
+        int index = gridY * width + gridX;
+        TileType oldType = tiles[index];
+        if (oldType == type) return;
+        
+        // Record the change, then let the derived caches catch up with it
+        tiles[index] = type;
+        journal.append(index, static_cast<std::uint8_t>(oldType), static_cast<std::uint8_t>(type), currentTick);
+        applyMutation(journal[journal.size() - 1]);
     }
+}
+
+void Dungeon::placeCrackedWalls() {
+    std::uniform_int_distribution<int> crackChance(1, 100);
+    
+    // Interior walls that border floor may be cracked (3% chance)
+    for (int y = 1; y < height - 1; y++) {
+        for (int x = 1; x < width - 1; x++) {
+            if (tiles[y * width + x] != TileType::WALL) continue;
+            
+            bool bordersFloor = !isBlocking(tiles[y * width + x - 1]) || !isBlocking(tiles[y * width + x + 1]) ||
+                                !isBlocking(tiles[(y - 1) * width + x]) || !isBlocking(tiles[(y + 1) * width + x]);
+            if (bordersFloor && crackChance(rng) <= 3) {
+                setTile(x, y, TileType::CRACKED_WALL);
+            }
+        }
+    }
+}
+
+int Dungeon::destroyWallsAround(sf::Vector2f center, float radius) {
+    int minX = std::max(1, static_cast<int>((center.x - radius) / TILE_SIZE));
+    int maxX = std::min(width - 2, static_cast<int>((center.x + radius) / TILE_SIZE));
+    int minY = std::max(1, static_cast<int>((center.y - radius) / TILE_SIZE));
+    int maxY = std::min(height - 2, static_cast<int>((center.y + radius) / TILE_SIZE));
+    
+    int destroyed = 0;
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            if (tiles[y * width + x] != TileType::CRACKED_WALL) continue;
+            
+            float dx = (x * TILE_SIZE + TILE_SIZE / 2) - center.x;
+            float dy = (y * TILE_SIZE + TILE_SIZE / 2) - center.y;
+            if (dx * dx + dy * dy <= radius * radius) {
+                setTileTypeAt(x * TILE_SIZE, y * TILE_SIZE, TileType::FLOOR);
+                destroyed++;
+            }
+        }
+    }
+    return destroyed;
+}
+
+bool Dungeon::isBlockingTile(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return true;
+    int index = y * width + x;
+    return (wallBits[index / 64] >> (index % 64)) & 1;
+}
+
+bool Dungeon::consumeDirty(int x0, int y0, int x1, int y1, std::uint8_t layer) {
+    // Tile rectangle (inclusive) to chunk rectangle
+    int cx0 = std::max(0, x0 / CHUNK_SIZE);
+    int cy0 = std::max(0, y0 / CHUNK_SIZE);
+    int cx1 = std::min(chunksX - 1, x1 / CHUNK_SIZE);
+    int cy1 = std::min(chunksY - 1, y1 / CHUNK_SIZE);
+    
+    bool dirty = false;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            std::uint8_t& flags = chunkDirty[cy * chunksX + cx];
+            if (flags & layer) {
+                dirty = true;
+                flags &= ~layer;
+            }
+        }
+    }
+    return dirty;
+}
+
+void Dungeon::updateDerived(sf::Vector2f focus) {
+    // Region labels: relabel only the chunks that changed, then merge across borders
+    for (int cy = 0; cy < chunksY; cy++) {
+        for (int cx = 0; cx < chunksX; cx++) {
+            std::uint8_t& flags = chunkDirty[cy * chunksX + cx];
+            if (flags & DIRTY_REGIONS) {
+                labelChunk(cx, cy);
+                flags &= ~DIRTY_REGIONS;
+                relabelledChunks.push_back(cy * chunksX + cx);
+            }
+        }
+    }
+    if (!relabelledChunks.empty()) {
+        mergeRegions();
+    }
+    
+    int focusX = std::max(0, std::min(width - 1, static_cast<int>(focus.x / TILE_SIZE)));
+    int focusY = std::max(0, std::min(height - 1, static_cast<int>(focus.y / TILE_SIZE)));
+    
+    // Windowed layers are redone when the focus moves to another tile or their window saw a change.
+    // Dirty bits are consumed either way so stale flags don't trigger a rebuild later.
+    bool navDirty = consumeDirty(focusX - NAV_RADIUS, focusY - NAV_RADIUS, focusX + NAV_RADIUS, focusY + NAV_RADIUS, DIRTY_NAVIGATION);
+    if (!navValid || navDirty || navTarget != sf::Vector2i(focusX, focusY)) {
+        computeNavigation(focusX, focusY);
+    }
+    
+    bool fovDirty = consumeDirty(focusX - FOV_RADIUS, focusY - FOV_RADIUS, focusX + FOV_RADIUS, focusY + FOV_RADIUS, DIRTY_FOV);
+    if (!fovValid || fovDirty || fovCenter != sf::Vector2i(focusX, focusY)) {
+        computeFieldOfView(focusX, focusY);
+    }
+}
+
+void Dungeon::labelChunk(int chunkX, int chunkY) {
+    int startX = chunkX * CHUNK_SIZE;
+    int startY = chunkY * CHUNK_SIZE;
+    int endX = std::min(width, startX + CHUNK_SIZE);
+    int endY = std::min(height, startY + CHUNK_SIZE);
+    
+    // Labels are unique across chunks: a chunk has at most CHUNK_SIZE^2 / 2
+    // components, so each gets a block of CHUNK_SIZE^2 labels
+    std::uint32_t base = static_cast<std::uint32_t>(chunkY * chunksX + chunkX) * CHUNK_SIZE * CHUNK_SIZE;
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            regionLabels[y * width + x] = 0;
+        }
+    }
+    
+    std::uint32_t nextLabel = 1;
+    int stack[CHUNK_SIZE * CHUNK_SIZE];
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            int seedIndex = y * width + x;
+            if (regionLabels[seedIndex] != 0 || isBlockingTile(x, y)) continue;
+            
+            // Flood fill this component, staying inside the chunk
+            std::uint32_t label = base + nextLabel++;
+            int top = 0;
+            stack[top++] = seedIndex;
+            regionLabels[seedIndex] = label;
+            
+            while (top > 0) {
+                int index = stack[--top];
+                int tx = index % width;
+                int ty = index / width;
+                const int offsets[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+                for (const auto& offset : offsets) {
+                    int nx = tx + offset[0];
+                    int ny = ty + offset[1];
+                    if (nx < startX || nx >= endX || ny < startY || ny >= endY) continue;
+                    int neighbour = ny * width + nx;
+                    if (regionLabels[neighbour] == 0 && !isBlockingTile(nx, ny)) {
+                        regionLabels[neighbour] = label;
+                        stack[top++] = neighbour;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Dungeon::mergeRegions() {
+    // Only regions touching a relabelled chunk can have changed: the chunk's
+    // new labels, and whatever lies across its borders, which is where any
+    // piece split off through it ends up. Each of those regions is walked
+    // again; the rest of the grid keeps its roots.
+    regionStamp++;
+    for (int chunk : relabelledChunks) {
+        int startX = (chunk % chunksX) * CHUNK_SIZE;
+        int startY = (chunk / chunksX) * CHUNK_SIZE;
+        int x0 = std::max(0, startX - 1);
+        int y0 = std::max(0, startY - 1);
+        int x1 = std::min(width, startX + CHUNK_SIZE + 1);
+        int y1 = std::min(height, startY + CHUNK_SIZE + 1);
+        for (int y = y0; y < y1; y++) {
+            for (int x = x0; x < x1; x++) {
+                std::uint32_t label = regionLabels[y * width + x];
+                if (label != 0 && regionMarks[label] != regionStamp) {
+                    walkRegion(label);
+                }
+            }
+        }
+    }
+    relabelledChunks.clear();
+}
+
+void Dungeon::walkRegion(std::uint32_t seed) {
+    // Breadth-first over labels, crossing chunk borders where tiles touch.
+    // The lowest label becomes the root, so a region's label doesn't depend
+    // on where the walk started.
+    regionQueue.clear();
+    regionQueue.push_back(seed);
+    regionMarks[seed] = regionStamp;
+    std::uint32_t lowest = seed;
+    
+    for (size_t next = 0; next < regionQueue.size(); next++) {
+        std::uint32_t label = regionQueue[next];
+        lowest = std::min(lowest, label);
+        
+        int chunk = static_cast<int>(label / (CHUNK_SIZE * CHUNK_SIZE));
+        int startX = (chunk % chunksX) * CHUNK_SIZE;
+        int startY = (chunk / chunksX) * CHUNK_SIZE;
+        int endX = std::min(width, startX + CHUNK_SIZE);
+        int endY = std::min(height, startY + CHUNK_SIZE);
+        auto cross = [&](int inside, int outside) {
+            if (regionLabels[inside] != label) return;
+            std::uint32_t other = regionLabels[outside];
+            if (other != 0 && regionMarks[other] != regionStamp) {
+                regionMarks[other] = regionStamp;
+                regionQueue.push_back(other);
+            }
+        };
+        
+        for (int y = startY; y < endY; y++) {
+            if (startX > 0) cross(y * width + startX, y * width + startX - 1);
+            if (endX < width) cross(y * width + endX - 1, y * width + endX);
+        }
+        for (int x = startX; x < endX; x++) {
+            if (startY > 0) cross(startY * width + x, (startY - 1) * width + x);
+            if (endY < height) cross((endY - 1) * width + x, endY * width + x);
+        }
+    }
+    
+    for (std::uint32_t label : regionQueue) {
+        regionRoots[label] = lowest;
+    }
+}
+
+void Dungeon::computeNavigation(int targetX, int targetY) {
+    const int size = 2 * NAV_RADIUS + 1;
+    navOrigin = sf::Vector2i(targetX - NAV_RADIUS, targetY - NAV_RADIUS);
+    navTarget = sf::Vector2i(targetX, targetY);
+    navValid = true;
+    std::fill(navDistance.begin(), navDistance.end(), 0xFFFF);
+    
+    // Breadth-first search outward from the target, clipped to the window.
+    // Each cell is queued at most once, so a flat array walked by a head
+    // index serves as the queue.
+    navFrontier.clear();
+    navDistance[NAV_RADIUS * size + NAV_RADIUS] = 0;
+    navFrontier.push_back(NAV_RADIUS * size + NAV_RADIUS);
+    
+    for (size_t head = 0; head < navFrontier.size(); head++) {
+        int cell = navFrontier[head];
+        int cx = cell % size;
+        int cy = cell / size;
+        
+        const int offsets[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+        for (const auto& offset : offsets) {
+            int nx = cx + offset[0];
+            int ny = cy + offset[1];
+            if (nx < 0 || nx >= size || ny < 0 || ny >= size) continue;
+            if (navDistance[ny * size + nx] != 0xFFFF) continue;
+            if (isBlockingTile(navOrigin.x + nx, navOrigin.y + ny)) continue;
+            
+            navDistance[ny * size + nx] = navDistance[cell] + 1;
+            navFrontier.push_back(ny * size + nx);
+        }
+    }
+}
+
+void Dungeon::computeFieldOfView(int centerX, int centerY) {
+    const int size = 2 * FOV_RADIUS + 1;
+    fovOrigin = sf::Vector2i(centerX - FOV_RADIUS, centerY - FOV_RADIUS);
+    fovCenter = sf::Vector2i(centerX, centerY);
+    fovValid = true;
+    std::fill(fovVisible.begin(), fovVisible.end(), 0);
+    
+    // Cast a ray to every cell on the window's edge; rays stop at the first blocking tile
+    for (int edge = 0; edge < size * 4; edge++) {
+        int side = edge / size;
+        int offset = edge % size;
+        int endX = side == 0 ? offset : side == 1 ? size - 1 : side == 2 ? size - 1 - offset : 0;
+        int endY = side == 0 ? 0 : side == 1 ? offset : side == 2 ? size - 1 : size - 1 - offset;
+        
+        int x = FOV_RADIUS, y = FOV_RADIUS;
+        int dx = std::abs(endX - x), dy = -std::abs(endY - y);
+        int stepX = x < endX ? 1 : -1, stepY = y < endY ? 1 : -1;
+        int error = dx + dy;
+        
+        while (true) {
+            int rx = x - FOV_RADIUS, ry = y - FOV_RADIUS;
+            if (rx * rx + ry * ry > FOV_RADIUS * FOV_RADIUS) break;
+            
+            fovVisible[y * size + x] = 1;
+            if (isBlockingTile(fovOrigin.x + x, fovOrigin.y + y) || (x == endX && y == endY)) break;
+            
+            int doubled = 2 * error;
+            if (doubled >= dy) { error += dy; x += stepX; }
+            if (doubled <= dx) { error += dx; y += stepY; }
+        }
+    }
+}
+
+std::uint32_t Dungeon::getRegion(float x, float y) const {
+    int gridX = static_cast<int>(x / TILE_SIZE);
+    int gridY = static_cast<int>(y / TILE_SIZE);
+    if (gridX < 0 || gridX >= width || gridY < 0 || gridY >= height) return 0;
+    return regionRoots[regionLabels[gridY * width + gridX]];
+}
+
+int Dungeon::getNavDistance(float x, float y) const {
+    const int size = 2 * NAV_RADIUS + 1;
+    int cx = static_cast<int>(x / TILE_SIZE) - navOrigin.x;
+    int cy = static_cast<int>(y / TILE_SIZE) - navOrigin.y;
+    if (!navValid || cx < 0 || cx >= size || cy < 0 || cy >= size) return -1;
+    
+    std::uint16_t distance = navDistance[cy * size + cx];
+    return distance == 0xFFFF ? -1 : distance;
+}
+
+sf::Vector2f Dungeon::getNavDirection(float x, float y) const {
+    int here = getNavDistance(x, y);
+    if (here <= 0) return sf::Vector2f(0, 0);
+    
+    // Step toward the neighbouring tile that is closer to the target
+    const int offsets[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+    for (const auto& offset : offsets) {
+        int distance = getNavDistance(x + offset[0] * TILE_SIZE, y + offset[1] * TILE_SIZE);
+        if (distance >= 0 && distance < here) {
+            return sf::Vector2f(offset[0], offset[1]);
+        }
+    }
+    return sf::Vector2f(0, 0);
+}
+
+bool Dungeon::isVisible(float x, float y) const {
+    const int size = 2 * FOV_RADIUS + 1;
+    int cx = static_cast<int>(x / TILE_SIZE) - fovOrigin.x;
+    int cy = static_cast<int>(y / TILE_SIZE) - fovOrigin.y;
+    if (!fovValid || cx < 0 || cx >= size || cy < 0 || cy >= size) return false;
+    return fovVisible[cy * size + cx] != 0;
 }
\ No newline at end of file
@@ -1,44 +1,30 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <memory_resource>
 #include <random>
+#include <cstdint>
+#include "LevelArena.h"
+#include "TileJournal.h"
 
-enum class TileType {
+enum class TileType : std::uint8_t {
     WALL,
     FLOOR,
     DOOR,
     TREASURE,
-    SPAWN
+    SPAWN,
+    STAIRS_DOWN,
+    STAIRS_UP,
+    CRACKED_WALL
 };
 
-struct Tile {
-    TileType type;
-    sf::RectangleShape shape;
-    sf::Vector2i gridPos;
-    
-    Tile(TileType t, float x, float y, int gx, int gy) 
-        : type(t), gridPos(gx, gy) {
-        shape.setSize(sf::Vector2f(32.0f, 32.0f));
-        shape.setPosition(x, y);
-        
-        switch(t) {
-            case TileType::WALL:
-                shape.setFillColor(sf::Color(100, 100, 100));
-                break;
-            case TileType::FLOOR:
-                shape.setFillColor(sf::Color(200, 200, 200));
-                break;
-            case TileType::DOOR:
-                shape.setFillColor(sf::Color(139, 69, 19));
-                break;
-            case TileType::TREASURE:
-                shape.setFillColor(sf::Color::Yellow);
-                break;
-            case TileType::SPAWN:
-                shape.setFillColor(sf::Color::Green);
-                break;
-        }
-    }
+// Grid-derived layers; each chunk keeps one dirty bit per layer
+enum DirtyLayer : std::uint8_t {
+    DIRTY_RENDER = 1,
+    DIRTY_REGIONS = 2,
+    DIRTY_NAVIGATION = 4,
+    DIRTY_FOV = 8,
+    DIRTY_ALL = 15
 };
 
 struct Room {
@@ -59,12 +45,55 @@ struct Room {
 
 class Dungeon {
 private:
-    std::vector<std::vector<Tile>> tiles;
-    std::vector<Room> rooms;
+    // Owns the grid, rooms and every cache below; regenerating releases them
+    // all with one reset. Declared first so it outlives the containers.
+    LevelArena arena;
+    bool generated;
+    
+    std::pmr::vector<TileType> tiles; // Row-major, index = y * width + x
+    std::pmr::vector<Room> rooms;
     int width, height;
     sf::Vector2i playerSpawn;
+    sf::Vector2i stairsDown;
+    unsigned int seed;
     std::mt19937 rng;
     
+    // Tile edits made after generation (treasure pickups etc.)
+    TileJournal journal;
+    std::uint32_t currentTick;
+    
+    // Caches derived from the grid, kept current by applyMutation
+    std::pmr::vector<std::uint64_t> wallBits;
+    std::pmr::vector<int> treasureTiles;
+    std::pmr::vector<sf::VertexArray> chunkVertices;
+    std::pmr::vector<std::uint8_t> chunkDirty; // DirtyLayer bits
+    int chunksX, chunksY;
+    
+    // Connected floor areas, labelled per chunk (0 = blocked). Labels that
+    // touch across a chunk border are merged; regionRoots maps every label
+    // to its region's, the lowest label in it.
+    std::pmr::vector<std::uint32_t> regionLabels;
+    std::pmr::vector<std::uint32_t> regionRoots;
+    std::pmr::vector<std::uint32_t> regionMarks; // Walk stamp per label
+    std::pmr::vector<std::uint32_t> regionQueue; // Labels of the region being walked
+    std::pmr::vector<int> relabelledChunks;      // Since the last merge
+    std::uint32_t regionStamp;
+    
+    // Distance field toward a target, limited to a window around it
+    std::pmr::vector<std::uint16_t> navDistance;
+    std::pmr::vector<int> navFrontier; // BFS queue, kept between searches
+    sf::Vector2i navOrigin;
+    sf::Vector2i navTarget;
+    bool navValid;
+    
+    // Tiles visible from the focus point, limited to a window around it
+    std::pmr::vector<std::uint8_t> fovVisible;
+    sf::Vector2i fovOrigin;
+    sf::Vector2i fovCenter;
+    bool fovValid;
+    
+    static size_t estimateLevelBytes(int w, int h);
+    void resetLevelStorage();
     void generateRooms();
     void generateCorridors();
     void createHorizontalTunnel(int x1, int x2, int y);
@@ -73,22 +102,73 @@ private:
     void createCrossShapedRoom(const Room& room);
     void addRoomFeatures(const Room& room);
     void placeTreasures();
+    void placeStairs(bool withStairsUp);
     void setTile(int x, int y, TileType type);
-    
+    void rebuildCaches();
+    void applyMutation(const TileMutation& mutation);
+    void rebuildChunk(int chunkX, int chunkY);
+    void placeCrackedWalls();
+    bool isBlockingTile(int x, int y) const;
+    bool consumeDirty(int x0, int y0, int x1, int y1, std::uint8_t layer);
+    void labelChunk(int chunkX, int chunkY);
+    void mergeRegions();
+    void walkRegion(std::uint32_t seed);
+    void computeNavigation(int targetX, int targetY);
+    void computeFieldOfView(int centerX, int centerY);
+
 public:
     Dungeon(int w, int h);
     
     void generate();
+    void generate(unsigned int levelSeed, bool withStairsUp);
+    void replay(const TileJournal& savedJournal);
     void render(sf::RenderWindow& window, const sf::View& view);
     bool isWall(float x, float y) const;
     bool isValidPosition(float x, float y) const;
+    
+    // How far along the segment (0..1) it gets before entering a blocking
+    // tile; 1 if it never does. Walks every tile crossed, so nothing tunnels.
+    float sweep(sf::Vector2f from, sf::Vector2f to) const;
     TileType getTileType(float x, float y) const;
     sf::Vector2f getPlayerSpawn() const;
-    std::vector<sf::Vector2f> getEnemySpawns(int count) const;
+    sf::Vector2f getStairsDown() const;
+    int getRoomAt(float x, float y) const; // -1 in corridors
+    sf::FloatRect getRoomBounds(int room) const;
+    std::pmr::vector<sf::Vector2f> getEnemySpawns(int count); // Allocated from the level arena
     void setTileTypeAt(float x, float y, TileType type);
+    int destroyWallsAround(sf::Vector2f center, float radius);
+    
+    // Bring regions, navigation and FOV up to date around the focus point.
+    // Only chunks touched since the last call are reworked.
+    void updateDerived(sf::Vector2f focus);
+    void refreshChunks(const sf::FloatRect& area);
+    std::uint32_t getRegion(float x, float y) const; // 0 on blocking tiles
+    int getNavDistance(float x, float y) const;
+    sf::Vector2f getNavDirection(float x, float y) const;
+    bool isVisible(float x, float y) const;
+    void setTick(std::uint32_t tick) { currentTick = tick; }
+    const TileJournal& getJournal() const { return journal; }
+    int getTreasureCount() const { return treasureTiles.size(); }
+    const std::pmr::vector<int>& getTreasureTiles() const { return treasureTiles; }
+    unsigned int getSeed() const { return seed; }
+    size_t getMemoryUsage() const;
+    const LevelArena& getArena() const { return arena; }
     int getRoomCount() const { return rooms.size(); }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     
+    const std::pmr::vector<TileType>& getTiles() const { return tiles; }
+    
+    static sf::Color getTileColor(TileType type);
+    // Quads for one CHUNK_SIZE square of a row-major grid; shared with
+    // renderers that draw from a copy of the tiles
+    static void buildChunkVertices(const TileType* grid, int gridWidth, int gridHeight, int chunkX, int chunkY,
+                                   sf::VertexArray& vertices);
+    static bool isBlocking(TileType type) { return type == TileType::WALL || type == TileType::CRACKED_WALL; }
+    static bool isTileType(std::uint8_t value) { return value <= static_cast<std::uint8_t>(TileType::CRACKED_WALL); }
+    
     static const int TILE_SIZE = 32;
+    static const int CHUNK_SIZE = 16; // Tiles per render chunk side
+    static const int NAV_RADIUS = 24; // Tiles around the target covered by the distance field
+    static const int FOV_RADIUS = 10;
 };
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "DungeonStack.h"
+#include "Archetypes.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <istream>
+#include <ostream>
+
+namespace {
+
+// Leftover enemies and pickups, field by field so there's no padding
+void writeLeftovers(std::ostream& out, const Floor& floor) {
+    std::uint32_t roomCount = floor.enemies.size();
+    out.write(reinterpret_cast<const char*>(&roomCount), sizeof(roomCount));
+    for (const std::vector<SpawnRecord>& records : floor.enemies) {
+        std::uint32_t enemyCount = records.size();
+        out.write(reinterpret_cast<const char*>(&enemyCount), sizeof(enemyCount));
+        for (const SpawnRecord& record : records) {
+            std::uint8_t type = static_cast<std::uint8_t>(record.type);
+            out.write(reinterpret_cast<const char*>(&record.x), sizeof(record.x));
+            out.write(reinterpret_cast<const char*>(&record.y), sizeof(record.y));
+            out.write(reinterpret_cast<const char*>(&record.health), sizeof(record.health));
+            out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+        }
+    }
+    
+    std::uint32_t powerUpCount = floor.powerUps.size();
+    out.write(reinterpret_cast<const char*>(&powerUpCount), sizeof(powerUpCount));
+    for (const PickupRecord& record : floor.powerUps) {
+        std::uint8_t type = static_cast<std::uint8_t>(record.type);
+        out.write(reinterpret_cast<const char*>(&record.x), sizeof(record.x));
+        out.write(reinterpret_cast<const char*>(&record.y), sizeof(record.y));
+        out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    }
+}
+
+// Finite and inside the level; the grid isn't generated yet, so walls
+// can't be checked here
+bool insideLevel(float x, float y, float levelWidth, float levelHeight) {
+    return std::isfinite(x) && std::isfinite(y) && x >= 0.0f && y >= 0.0f && x < levelWidth && y < levelHeight;
+}
+
+bool readLeftovers(std::istream& in, Floor& floor, float levelWidth, float levelHeight) {
+    // Counts are checked as the records arrive, so a bad one runs out of
+    // stream instead of reserving memory
+    std::uint32_t roomCount = 0;
+    if (!in.read(reinterpret_cast<char*>(&roomCount), sizeof(roomCount))) return false;
+    for (std::uint32_t room = 0; room < roomCount; room++) {
+        std::uint32_t enemyCount = 0;
+        if (!in.read(reinterpret_cast<char*>(&enemyCount), sizeof(enemyCount))) return false;
+        floor.enemies.emplace_back();
+        for (std::uint32_t i = 0; i < enemyCount; i++) {
+            SpawnRecord record;
+            std::uint8_t type = 0;
+            in.read(reinterpret_cast<char*>(&record.x), sizeof(record.x));
+            in.read(reinterpret_cast<char*>(&record.y), sizeof(record.y));
+            in.read(reinterpret_cast<char*>(&record.health), sizeof(record.health));
+            in.read(reinterpret_cast<char*>(&type), sizeof(type));
+            if (!in || type > static_cast<std::uint8_t>(EnemyType::SKELETON) ||
+                !insideLevel(record.x, record.y, levelWidth, levelHeight)) {
+                return false;
+            }
+            record.type = static_cast<EnemyType>(type);
+            
+            // 0 is full health; anything else stays within what the type can have
+            if (record.health != 0) {
+                int maxHealth = std::min(Archetypes::enemy(record.type).health, 0x7FFF);
+                record.health = static_cast<std::int16_t>(std::clamp<int>(record.health, 1, maxHealth));
+            }
+            floor.enemies.back().push_back(record);
+        }
+    }
+    
+    std::uint32_t powerUpCount = 0;
+    if (!in.read(reinterpret_cast<char*>(&powerUpCount), sizeof(powerUpCount))) return false;
+    for (std::uint32_t i = 0; i < powerUpCount; i++) {
+        PickupRecord record;
+        std::uint8_t type = 0;
+        in.read(reinterpret_cast<char*>(&record.x), sizeof(record.x));
+        in.read(reinterpret_cast<char*>(&record.y), sizeof(record.y));
+        in.read(reinterpret_cast<char*>(&type), sizeof(type));
+        if (!in || type > static_cast<std::uint8_t>(PowerUpType::ARMOR_BOOST) ||
+            !insideLevel(record.x, record.y, levelWidth, levelHeight)) {
+            return false;
+        }
+        record.type = static_cast<PowerUpType>(type);
+        floor.powerUps.push_back(record);
+    }
+    return true;
+}
+
+} // namespace
+
+DungeonStack::DungeonStack(int w, int h, unsigned int seed, size_t budgetBytes)
+    : width(w), height(h), baseSeed(seed), memoryBudget(budgetBytes) {
+}
+
+unsigned int DungeonStack::seedForFloor(int index) const {
+    // Mix the run seed with the floor number so every floor gets its own layout
+    unsigned int x = baseSeed ^ (static_cast<unsigned int>(index) * 0x9E3779B9u);
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+Floor& DungeonStack::getFloor(int index) {
+    // Floors are created lazily the first time they are reached
+    while (static_cast<int>(floors.size()) <= index) {
+        Floor floor;
+        floor.seed = seedForFloor(floors.size());
+        floors.push_back(std::move(floor));
+    }
+    return floors[index];
+}
+
+Dungeon& DungeonStack::getDungeon(int index) {
+    Floor& floor = getFloor(index);
+    
+    if (!floor.dungeon) {
+        floor.dungeon = std::make_unique<Dungeon>(width, height);
+        floor.dungeon->generate(floor.seed, index > 0);
+        
+        if (!floor.journal.empty()) {
+            floor.dungeon->replay(floor.journal);
+            std::cout << "Regenerated floor " << index + 1 << " from seed (" << floor.journal.size() << " tile changes)" << std::endl;
+        }
+    }
+    
+    touch(index);
+    evictToBudget(index);
+    
+    return *floor.dungeon;
+}
+
+void DungeonStack::touch(int index) {
+    residentFloors.remove(index);
+    residentFloors.push_front(index);
+}
+
+void DungeonStack::evictToBudget(int keepIndex) {
+    // Drop least recently used floors until we fit, never the one in use
+    while (getResidentMemory() > memoryBudget && residentFloors.size() > 1) {
+        int victim = residentFloors.back();
+        if (victim == keepIndex) break;
+        evict(victim);
+    }
+}
+
+void DungeonStack::evict(int index) {
+    Floor& floor = floors[index];
+    if (floor.dungeon) {
+        floor.journal = floor.dungeon->getJournal();
+        floor.dungeon.reset();
+        std::cout << "Evicted floor " << index + 1 << " (keeping seed and " << floor.journal.size() << " tile changes)" << std::endl;
+    }
+    residentFloors.remove(index);
+}
+
+size_t DungeonStack::getResidentMemory() const {
+    size_t total = 0;
+    for (int index : residentFloors) {
+        total += floors[index].dungeon->getMemoryUsage();
+    }
+    return total;
+}
+
+void DungeonStack::save(std::ostream& out) const {
+    std::uint32_t floorCount = floors.size();
+    out.write(reinterpret_cast<const char*>(&baseSeed), sizeof(baseSeed));
+    out.write(reinterpret_cast<const char*>(&floorCount), sizeof(floorCount));
+    
+    for (const auto& floor : floors) {
+        std::uint8_t flags = (floor.visited ? 1 : 0) | (floor.cleared ? 2 : 0);
+        std::int32_t progress[3] = { floor.treasuresCollected, floor.enemiesKilled, floor.initialEnemyCount };
+        out.write(reinterpret_cast<const char*>(&floor.seed), sizeof(floor.seed));
+        out.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+        out.write(reinterpret_cast<const char*>(progress), sizeof(progress));
+        
+        // Resident floors may have changes newer than the stored journal
+        if (floor.dungeon) {
+            floor.dungeon->getJournal().write(out);
+        } else {
+            floor.journal.write(out);
+        }
+        writeLeftovers(out, floor);
+    }
+}
+
+bool DungeonStack::load(std::istream& in) {
+    std::uint32_t floorCount = 0;
+    if (!in.read(reinterpret_cast<char*>(&baseSeed), sizeof(baseSeed)) ||
+        !in.read(reinterpret_cast<char*>(&floorCount), sizeof(floorCount))) {
+        return false;
+    }
+    
+    floors.clear();
+    residentFloors.clear();
+    const float levelWidth = static_cast<float>(width * Dungeon::TILE_SIZE);
+    const float levelHeight = static_cast<float>(height * Dungeon::TILE_SIZE);
+    
+    for (std::uint32_t i = 0; i < floorCount; i++) {
+        Floor floor;
+        std::uint8_t flags = 0;
+        std::int32_t progress[3] = {};
+        in.read(reinterpret_cast<char*>(&floor.seed), sizeof(floor.seed));
+        in.read(reinterpret_cast<char*>(&flags), sizeof(flags));
+        in.read(reinterpret_cast<char*>(progress), sizeof(progress));
+        if (!in || !floor.journal.read(in) || !readLeftovers(in, floor, levelWidth, levelHeight)) {
+            return false;
+        }
+        
+        // Progress feeds spawning and victory checks; journal entries are
+        // replayed straight into the grid
+        if (progress[0] < 0 || progress[1] < 0 || progress[2] < 0 || progress[1] > progress[2]) {
+            return false;
+        }
+        for (const TileMutation& mutation : floor.journal.getEntries()) {
+            if (mutation.index >= static_cast<std::uint32_t>(width * height) ||
+                !Dungeon::isTileType(mutation.oldType) || !Dungeon::isTileType(mutation.newType)) {
+                return false;
+            }
+        }
+        
+        floor.visited = flags & 1;
+        floor.cleared = flags & 2;
+        floor.treasuresCollected = progress[0];
+        floor.enemiesKilled = progress[1];
+        floor.initialEnemyCount = progress[2];
+        floors.push_back(std::move(floor));
+    }
+    
+    // Floors are regenerated from seed + journal when next entered
+    return true;
+}
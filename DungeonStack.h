@@ -0,0 +1,62 @@
+#pragma once
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <vector>
+#include "Dungeon.h"
+#include "EnemySpawner.h"
+#include "PowerUp.h"
+
+// Uncollected power-up on a floor the player has left
+struct PickupRecord {
+    float x, y;
+    PowerUpType type;
+};
+
+// Per-floor record. A floor that is not resident keeps only its seed and tile journal,
+// which is enough to regenerate it exactly on the next visit.
+struct Floor {
+    unsigned int seed;
+    TileJournal journal;
+    std::unique_ptr<Dungeon> dungeon;
+    
+    // Progress on this floor
+    bool visited = false;
+    bool cleared = false;
+    int treasuresCollected = 0;
+    int enemiesKilled = 0;
+    int initialEnemyCount = 0;
+    
+    // What the player left behind, put back on the next visit
+    std::vector<std::vector<SpawnRecord>> enemies; // Per room
+    std::vector<PickupRecord> powerUps;
+};
+
+class DungeonStack {
+private:
+    std::vector<Floor> floors;
+    std::list<int> residentFloors; // Most recently used first
+    int width, height;
+    unsigned int baseSeed;
+    size_t memoryBudget;
+    
+    unsigned int seedForFloor(int index) const;
+    void touch(int index);
+    void evictToBudget(int keepIndex);
+    void evict(int index);
+    
+public:
+    DungeonStack(int w, int h, unsigned int seed, size_t budgetBytes);
+    
+    Dungeon& getDungeon(int index);
+    Floor& getFloor(int index);
+    
+    int getFloorCount() const { return floors.size(); }
+    int getResidentCount() const { return residentFloors.size(); }
+    size_t getResidentMemory() const;
+    size_t getMemoryBudget() const { return memoryBudget; }
+    
+    // Saves are the run seed plus each floor's progress, journal and leftovers
+    void save(std::ostream& out) const;
+    bool load(std::istream& in);
+};
@@ -0,0 +1,152 @@
+#include "EnemySpawner.h"
+#include "Dungeon.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+SpawnRecord recordFor(const EnemyStore& enemies, size_t i) {
+    SpawnRecord record;
+    sf::Vector2f pos = enemies.getPosition(i);
+    record.x = pos.x;
+    record.y = pos.y;
+    record.health = static_cast<std::int16_t>(enemies.getHealth(i) < enemies.getMaxHealth(i) ? enemies.getHealth(i) : 0);
+    record.type = enemies.getType(i);
+    return record;
+}
+
+} // namespace
+
+EnemySpawner::EnemySpawner(float activation, float deactivation)
+    : activationRadius(activation)
+    , deactivationRadius(deactivation)
+    , dormantCount(0) {
+}
+
+void EnemySpawner::reset(const Dungeon& dungeon) {
+    int roomCount = dungeon.getRoomCount();
+    
+    // Keep the per-room buffers from the last floor so refilling them doesn't allocate
+    roomRecords.resize(roomCount);
+    for (std::vector<SpawnRecord>& records : roomRecords) {
+        records.clear();
+    }
+    roomBounds.resize(roomCount);
+    roomActive.assign(roomCount, 0);
+    for (int i = 0; i < roomCount; i++) {
+        roomBounds[i] = dungeon.getRoomBounds(i);
+    }
+    dormantCount = 0;
+}
+
+void EnemySpawner::addRecord(EnemyType type, float x, float y) {
+    if (roomBounds.empty()) return;
+    
+    SpawnRecord record;
+    record.x = x;
+    record.y = y;
+    record.health = 0;
+    record.type = type;
+    roomRecords[nearestRoom(sf::Vector2f(x, y))].push_back(record);
+    dormantCount++;
+}
+
+int EnemySpawner::nearestRoom(sf::Vector2f point) const {
+    // Spawns normally sit inside a room; fall back to the closest one
+    int room = 0;
+    float bestDistance = distanceToRect(point, roomBounds[0]);
+    for (size_t i = 1; i < roomBounds.size() && bestDistance > 0.0f; i++) {
+        float distance = distanceToRect(point, roomBounds[i]);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            room = static_cast<int>(i);
+        }
+    }
+    return room;
+}
+
+void EnemySpawner::collectRecords(const EnemyStore& enemies, std::vector<std::vector<SpawnRecord>>& out) const {
+    out.resize(roomRecords.size());
+    for (size_t room = 0; room < roomRecords.size(); room++) {
+        out[room] = roomRecords[room];
+    }
+    
+    // Live enemies go back to the room they came from, as deactivation would put them
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (enemies.isDead(i) || out.empty()) continue;
+        std::int32_t room = enemies.getHome(i);
+        if (room < 0 || room >= static_cast<std::int32_t>(out.size())) {
+            room = nearestRoom(enemies.getPosition(i));
+        }
+        out[room].push_back(recordFor(enemies, i));
+    }
+}
+
+void EnemySpawner::restoreRecords(const std::vector<std::vector<SpawnRecord>>& records) {
+    if (roomBounds.empty()) return;
+    
+    for (size_t room = 0; room < records.size(); room++) {
+        for (const SpawnRecord& record : records[room]) {
+            size_t target = room < roomRecords.size() ? room : nearestRoom(sf::Vector2f(record.x, record.y));
+            roomRecords[target].push_back(record);
+            dormantCount++;
+        }
+    }
+}
+
+void EnemySpawner::update(sf::Vector2f playerPos, EnemyStore& enemies) {
+    for (size_t room = 0; room < roomBounds.size(); room++) {
+        float distance = distanceToRect(playerPos, roomBounds[room]);
+        if (!roomActive[room] && distance <= activationRadius) {
+            activateRoom(static_cast<int>(room), enemies);
+        } else if (roomActive[room] && distance > deactivationRadius) {
+            roomActive[room] = 0;
+        }
+    }
+    
+    deactivateDistant(playerPos, enemies);
+}
+
+void EnemySpawner::activateRoom(int room, EnemyStore& enemies) {
+    roomActive[room] = 1;
+    
+    std::vector<SpawnRecord>& records = roomRecords[room];
+    for (const SpawnRecord& record : records) {
+        size_t i = enemies.spawn(record.type, record.x, record.y, room);
+        if (record.health > 0) {
+            enemies.setHealth(i, record.health);
+        }
+    }
+    dormantCount -= records.size();
+    records.clear();
+}
+
+void EnemySpawner::deactivateDistant(sf::Vector2f playerPos, EnemyStore& enemies) {
+    const float limitSq = deactivationRadius * deactivationRadius;
+    
+    // Backwards, so swap-and-pop only moves enemies already checked
+    for (size_t i = enemies.size(); i-- > 0;) {
+        std::int32_t room = enemies.getHome(i);
+        if (room < 0 || roomActive[room]) continue;
+        
+        // Chasers go too: this far out they can't see the player, and once
+        // out of the level of detail radius they sleep in CHASE for good
+        AIState state = enemies.getState(i);
+        if (state == AIState::ATTACK || state == AIState::DEAD) continue;
+        
+        sf::Vector2f pos = enemies.getPosition(i);
+        float dx = pos.x - playerPos.x;
+        float dy = pos.y - playerPos.y;
+        if (dx * dx + dy * dy <= limitSq) continue;
+        
+        roomRecords[room].push_back(recordFor(enemies, i));
+        dormantCount++;
+        enemies.remove(i);
+    }
+}
+
+float EnemySpawner::distanceToRect(sf::Vector2f point, const sf::FloatRect& rect) {
+    float dx = std::max(0.0f, std::max(rect.left - point.x, point.x - (rect.left + rect.width)));
+    float dy = std::max(0.0f, std::max(rect.top - point.y, point.y - (rect.top + rect.height)));
+    return std::sqrt(dx * dx + dy * dy);
+}
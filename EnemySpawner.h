@@ -0,0 +1,55 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "EnemyStore.h"
+
+class Dungeon;
+
+// Dormant enemy, small enough to keep thousands per floor
+struct SpawnRecord {
+    float x, y;
+    std::int16_t health; // 0 means full health
+    EnemyType type;
+};
+
+// Keeps enemies as per-room spawn records until the player comes within the
+// activation radius of their room, then turns them into live enemies. Enemies
+// that wander far from the player while their room is inactive are packed
+// back into records. The live store therefore only holds the player's
+// neighbourhood, however big the floor is.
+class EnemySpawner {
+private:
+    std::vector<std::vector<SpawnRecord>> roomRecords;
+    std::vector<sf::FloatRect> roomBounds;
+    std::vector<std::uint8_t> roomActive;
+    float activationRadius;
+    float deactivationRadius; // Larger, so rooms near the edge don't flicker
+    size_t dormantCount;
+    
+    void activateRoom(int room, EnemyStore& enemies);
+    void deactivateDistant(sf::Vector2f playerPos, EnemyStore& enemies);
+    int nearestRoom(sf::Vector2f point) const;
+    
+public:
+    EnemySpawner(float activation = 320.0f, float deactivation = 640.0f);
+    
+    // Rooms come from the dungeon; existing records are dropped
+    void reset(const Dungeon& dungeon);
+    
+    // Records outside every room go to the nearest one
+    void addRecord(EnemyType type, float x, float y);
+    
+    // Every enemy still on the floor, dormant or live, as records per room;
+    // for leaving the floor and coming back to it as it was
+    void collectRecords(const EnemyStore& enemies, std::vector<std::vector<SpawnRecord>>& out) const;
+    void restoreRecords(const std::vector<std::vector<SpawnRecord>>& records); // After reset()
+    
+    // Activate rooms near the player, deactivate far enemies of inactive rooms
+    void update(sf::Vector2f playerPos, EnemyStore& enemies);
+    
+    size_t getDormantCount() const { return dormantCount; }
+    size_t getRoomCount() const { return roomBounds.size(); }
+    
+    static float distanceToRect(sf::Vector2f point, const sf::FloatRect& rect);
+};
@@ -0,0 +1,1009 @@
+#include "EnemyStore.h"
+#include "Archetypes.h"
+#include "Combat.h"
+#include "Dungeon.h"
+#include "SimdKernels.h"
+#include "ThreadPool.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+const float EnemyStore::ENEMY_SIZE = 24.0f;
+const float EnemyStore::FAR_DISTANCE = std::numeric_limits<float>::max();
+const size_t EnemyStore::PARALLEL_GRAIN = 2048;
+const float EnemyStore::MAX_CATCHUP = 0.25f;
+const float EnemyStore::SQUAD_CELL = 256.0f;
+const float EnemyStore::THREAT_MEMORY = 3.0f;
+const float EnemyStore::FLANK_RADIUS = 48.0f;
+const float EnemyStore::IDLE_TIME = 2.0f;
+
+namespace {
+
+template <typename T>
+void swapAndPop(std::vector<T>& values, size_t i) {
+    values[i] = values.back();
+    values.pop_back();
+}
+
+// Small per-enemy generator so patrol targets don't depend on update order
+std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+EnemyStore::EnemyStore()
+    : grid(0.0f, 0.0f, 2.0f * Dungeon::TILE_SIZE)
+    , senseRadius(0.0f)
+    , workers(nullptr)
+    , dungeon(nullptr)
+    , squadOfCell(1, -1)
+    , squadCellsX(1)
+    , squadCellsY(1)
+    , frameCounter(0)
+    , simTime(0.0)
+    , lodCursor(0)
+    , bucketStart()
+    , stateCounts() {
+}
+
+size_t EnemyStore::spawn(EnemyType enemyType, float x, float y, std::int32_t homeGroup) {
+    posX.push_back(x);
+    posY.push_back(y);
+    prevX.push_back(x);
+    prevY.push_back(y);
+    velX.push_back(0.0f);
+    velY.push_back(0.0f);
+    type.push_back(enemyType);
+    health.push_back(Archetypes::enemy(enemyType).health);
+    attackReadyAt.push_back(simTime);
+    lastHitBy.push_back(0);
+    patrolTargetX.push_back(x);
+    patrolTargetY.push_back(y);
+    aiState.push_back(AIState::PATROL);
+    stateCounts[static_cast<size_t>(AIState::PATROL)]++;
+    idleUntil.push_back(0.0);
+    timerSlot.push_back(-1);
+    idleNext.push_back(-1);
+    idlePrev.push_back(-1);
+    flash.push_back(FLASH_NONE);
+    home.push_back(homeGroup);
+    std::uint32_t squadId = joinSquad(x, y, homeGroup);
+    squad.push_back(squadId);
+    squadSlot.push_back(squads[squadId].nextSlot++);
+    playerDistance.push_back(FAR_DISTANCE);
+    playerDirX.push_back(0.0f);
+    playerDirY.push_back(0.0f);
+    lodTier.push_back(LOD_FULL);
+    awakeSlot.push_back(-1);
+    lastTickFrame.push_back(frameCounter);
+    lastTickTime.push_back(simTime);
+    
+    // Seed from the spawn position so a level replays the same way
+    std::uint32_t seed = static_cast<std::uint32_t>(x) * 73856093u ^ static_cast<std::uint32_t>(y) * 19349663u ^ (size() * 83492791u);
+    rngState.push_back(seed != 0 ? seed : 1u);
+    
+    // Generate initial patrol target
+    size_t i = size() - 1;
+    generatePatrolTarget(i);
+    grid.insert(i, sf::Vector2f(x, y));
+    wake(i);
+    return i;
+}
+
+void EnemyStore::remove(size_t i) {
+    size_t last = size() - 1;
+    grid.remove(i);
+    grid.rename(last, i);
+    
+    // Keep the awake list and last frame's near set pointing at the right rows
+    if (lodTier[i] != LOD_SLEEP) sleep(i);
+    if (last != i && lodTier[last] != LOD_SLEEP) awakeList[awakeSlot[last]] = static_cast<std::uint32_t>(i);
+    // The removed row leaves the near set first: when it is the last row,
+    // nothing is renamed over it and it would point past the end
+    nearPlayer.erase(std::remove(nearPlayer.begin(), nearPlayer.end(), static_cast<std::uint32_t>(i)), nearPlayer.end());
+    for (std::uint32_t& id : nearPlayer) {
+        if (id == last) id = static_cast<std::uint32_t>(i);
+    }
+    
+    // Same for the idle timer heap and the squads' parked lists
+    stateCounts[static_cast<size_t>(aiState[i])]--;
+    if (aiState[i] == AIState::IDLE) unpark(i);
+    if (last != i && aiState[last] == AIState::IDLE) {
+        std::int32_t renamed = static_cast<std::int32_t>(i);
+        idleTimers[timerSlot[last]] = static_cast<std::uint32_t>(i);
+        if (idlePrev[last] >= 0) idleNext[idlePrev[last]] = renamed;
+        else squads[squad[last]].idleHead = renamed;
+        if (idleNext[last] >= 0) idlePrev[idleNext[last]] = renamed;
+    }
+    
+    // The enemy renamed to i may have moved last update under its old index
+    if (last != i) {
+        movedList.push_back(static_cast<std::uint32_t>(i));
+    }
+    
+    swapAndPop(posX, i);
+    swapAndPop(posY, i);
+    swapAndPop(prevX, i);
+    swapAndPop(prevY, i);
+    swapAndPop(velX, i);
+    swapAndPop(velY, i);
+    swapAndPop(type, i);
+    swapAndPop(health, i);
+    swapAndPop(attackReadyAt, i);
+    swapAndPop(lastHitBy, i);
+    swapAndPop(patrolTargetX, i);
+    swapAndPop(patrolTargetY, i);
+    swapAndPop(aiState, i);
+    swapAndPop(idleUntil, i);
+    swapAndPop(timerSlot, i);
+    swapAndPop(idleNext, i);
+    swapAndPop(idlePrev, i);
+    swapAndPop(rngState, i);
+    swapAndPop(flash, i);
+    squads[squad[i]].members--;
+    swapAndPop(home, i);
+    swapAndPop(squad, i);
+    swapAndPop(squadSlot, i);
+    swapAndPop(playerDistance, i);
+    swapAndPop(playerDirX, i);
+    swapAndPop(playerDirY, i);
+    swapAndPop(lodTier, i);
+    swapAndPop(awakeSlot, i);
+    swapAndPop(lastTickFrame, i);
+    swapAndPop(lastTickTime, i);
+}
+
+void EnemyStore::clear() {
+    posX.clear(); posY.clear();
+    prevX.clear(); prevY.clear(); movedList.clear();
+    velX.clear(); velY.clear();
+    type.clear(); health.clear();
+    attackReadyAt.clear(); lastHitBy.clear();
+    patrolTargetX.clear(); patrolTargetY.clear();
+    aiState.clear(); rngState.clear(); flash.clear(); home.clear();
+    idleUntil.clear(); timerSlot.clear(); idleNext.clear(); idlePrev.clear();
+    idleTimers.clear();
+    std::fill(stateCounts, stateCounts + STATE_COUNT, 0);
+    squad.clear(); squadSlot.clear();
+    squads.clear(); sensedSquads.clear();
+    std::fill(squadOfHome.begin(), squadOfHome.end(), -1);
+    std::fill(squadOfCell.begin(), squadOfCell.end(), -1);
+    playerDistance.clear();
+    playerDirX.clear(); playerDirY.clear();
+    lodTier.clear(); awakeSlot.clear(); lastTickFrame.clear(); lastTickTime.clear();
+    nearPlayer.clear();
+    tickList.clear(); tickStep.clear();
+    awakeList.clear();
+    lodCursor = 0;
+    grid.clear();
+    
+    // Start the clock over, so a floor plays out the same whatever came before
+    frameCounter = 0;
+    simTime = 0.0;
+}
+
+void EnemyStore::setWorldBounds(float worldWidth, float worldHeight) {
+    grid.reset(worldWidth, worldHeight);
+    squadCellsX = std::max(1, static_cast<int>(std::ceil(worldWidth / SQUAD_CELL)));
+    squadCellsY = std::max(1, static_cast<int>(std::ceil(worldHeight / SQUAD_CELL)));
+    squadOfCell.assign(static_cast<size_t>(squadCellsX) * squadCellsY, -1);
+    for (size_t i = 0; i < size(); i++) {
+        grid.insert(i, sf::Vector2f(posX[i], posY[i]));
+        
+        // Existing roaming squads stay joinable where their members stand
+        if (home[i] < 0) {
+            std::int32_t& entry = squadOfCell[squadCellIndex(posX[i], posY[i])];
+            if (entry < 0) entry = static_cast<std::int32_t>(squad[i]);
+        }
+    }
+}
+
+void EnemyStore::reserve(size_t capacity) {
+    posX.reserve(capacity); posY.reserve(capacity);
+    prevX.reserve(capacity); prevY.reserve(capacity);
+    velX.reserve(capacity); velY.reserve(capacity);
+    type.reserve(capacity); health.reserve(capacity);
+    attackReadyAt.reserve(capacity); lastHitBy.reserve(capacity);
+    patrolTargetX.reserve(capacity); patrolTargetY.reserve(capacity);
+    aiState.reserve(capacity); rngState.reserve(capacity); flash.reserve(capacity); home.reserve(capacity);
+    idleUntil.reserve(capacity); timerSlot.reserve(capacity); idleNext.reserve(capacity); idlePrev.reserve(capacity);
+    squad.reserve(capacity); squadSlot.reserve(capacity);
+    playerDistance.reserve(capacity);
+    playerDirX.reserve(capacity); playerDirY.reserve(capacity);
+    lodTier.reserve(capacity); awakeSlot.reserve(capacity); lastTickFrame.reserve(capacity); lastTickTime.reserve(capacity);
+}
+
+void EnemyStore::update(float deltaTime, sf::Vector2f playerPos, sf::Vector2f viewCenter) {
+    // Chasing enemies give up at 1.5x their detection range. Taken from the
+    // archetypes each frame so a tuning reload applies straight away.
+    senseRadius = Archetypes::maxDetectionRange() * 1.5f;
+    
+    // Distances and directions to the player are the frozen snapshot the
+    // parallel phase reads
+    measurePlayerDistance(playerPos);
+    frameCounter++;
+    simTime += deltaTime;
+    
+    // Interpolation starts from where each enemy is now. Only the ones that
+    // moved last update are anywhere else, so only they catch up; indices
+    // past the end were removed since.
+    for (std::uint32_t i : movedList) {
+        if (i < size()) {
+            prevX[i] = posX[i];
+            prevY[i] = posY[i];
+        }
+    }
+    
+    // Parked enemies cost nothing until their idle time runs out
+    sf::Clock timerClock;
+    fireIdleTimers();
+    stateTimes[static_cast<size_t>(AIState::IDLE)] = timerClock.getElapsedTime();
+    
+    // Pick which enemies think this frame, and how much time each catches up
+    scheduleTicks(viewCenter);
+    
+    // One perception check per squad with a member thinking this frame
+    senseSquads(playerPos);
+    
+    // One loop per state over its slice of the schedule. Each enemy only
+    // reads the snapshot and writes its own row, so any split across threads
+    // gives the same result. State changes are queued and applied afterwards,
+    // so no loop sees an enemy switch buckets under it.
+    sortIntoBuckets();
+    runBucket(AIState::PATROL);
+    runBucket(AIState::CHASE);
+    runBucket(AIState::ATTACK);
+    applyTransitions();
+    
+    // Steering reads other enemies' desired velocities, so it gets its own
+    // pass before anyone moves
+    const size_t scheduled = tickList.size();
+    steerX.resize(scheduled);
+    steerY.resize(scheduled);
+    if (crowd.enabled) {
+        runParallel(scheduled, [this](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; k++) {
+                steer(k);
+            }
+        });
+    } else {
+        for (size_t k = 0; k < scheduled; k++) {
+            steerX[k] = velX[tickList[k]];
+            steerY[k] = velY[tickList[k]];
+        }
+    }
+    
+    runParallel(scheduled, [this](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            size_t i = tickList[k];
+            velX[i] = steerX[k];
+            velY[i] = steerY[k];
+            integrate(i, tickStep[k]);
+        }
+    });
+    
+    // Grid links are shared, so they're updated serially in schedule order
+    for (std::uint32_t i : tickList) {
+        grid.move(i, sf::Vector2f(posX[i], posY[i]));
+    }
+    movedList.assign(tickList.begin(), tickList.end());
+    
+    // Combat checks after this update use post-movement distances
+    measurePlayerDistance(playerPos);
+}
+
+std::uint32_t EnemyStore::joinSquad(float x, float y, std::int32_t homeGroup) {
+    // Flat lookup tables rather than a map, so joining never allocates once
+    // the tables have grown to the level's size
+    std::int32_t* entry;
+    if (homeGroup >= 0) {
+        if (static_cast<size_t>(homeGroup) >= squadOfHome.size()) {
+            squadOfHome.resize(homeGroup + 1, -1);
+        }
+        entry = &squadOfHome[homeGroup];
+    } else {
+        entry = &squadOfCell[squadCellIndex(x, y)];
+    }
+    
+    if (*entry < 0) {
+        *entry = static_cast<std::int32_t>(squads.size());
+        squads.push_back(SquadBlackboard());
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(*entry);
+    squads[id].members++;
+    return id;
+}
+
+size_t EnemyStore::squadCellIndex(float x, float y) const {
+    // Positions outside the world share the border cells
+    int cellX = std::max(0, std::min(squadCellsX - 1, static_cast<int>(std::floor(x / SQUAD_CELL))));
+    int cellY = std::max(0, std::min(squadCellsY - 1, static_cast<int>(std::floor(y / SQUAD_CELL))));
+    return static_cast<size_t>(cellY) * squadCellsX + cellX;
+}
+
+void EnemyStore::senseSquads(sf::Vector2f playerPos) {
+    // The scheduled member nearest its own detection range speaks for the squad
+    sensedSquads.clear();
+    for (std::uint32_t i : tickList) {
+        SquadBlackboard& board = squads[squad[i]];
+        float detection = Archetypes::enemy(type[i]).detectionRange;
+        float margin = playerDistance[i] == FAR_DISTANCE ? FAR_DISTANCE : playerDistance[i] - detection;
+        if (board.sensedFrame != frameCounter) {
+            board.sensedFrame = frameCounter;
+            board.closest = static_cast<std::int32_t>(i);
+            board.closestMargin = margin;
+            sensedSquads.push_back(squad[i]);
+        } else if (margin < board.closestMargin) {
+            board.closest = static_cast<std::int32_t>(i);
+            board.closestMargin = margin;
+        }
+    }
+    
+    for (std::uint32_t id : sensedSquads) {
+        SquadBlackboard& board = squads[id];
+        size_t scout = board.closest;
+        
+        // Hunting squads keep sight out to 1.5x detection range
+        float reach = Archetypes::enemy(type[scout]).detectionRange * (board.threat > 0.0f ? 1.5f : 1.0f);
+        bool inRange = playerDistance[scout] <= reach;
+        bool sees = board.alertPending || (inRange && (!dungeon || dungeon->isVisible(posX[scout], posY[scout])));
+        
+        board.playerVisible = sees;
+        if (sees) {
+            board.lastKnownX = playerPos.x;
+            board.lastKnownY = playerPos.y;
+            board.threat = 1.0f;
+        } else {
+            float elapsed = static_cast<float>(simTime - board.lastSensed);
+            board.threat = std::max(0.0f, board.threat - elapsed / THREAT_MEMORY);
+        }
+        board.lastSensed = simTime;
+        board.alertPending = false;
+        
+        // Parked members join the hunt; unparking pops them off the list
+        if (board.threat > 0.0f) {
+            while (board.idleHead >= 0) {
+                setState(board.idleHead, AIState::CHASE);
+            }
+        }
+    }
+}
+
+void EnemyStore::setState(size_t i, AIState state) {
+    AIState previous = aiState[i];
+    if (previous == state) return;
+    stateCounts[static_cast<size_t>(previous)]--;
+    stateCounts[static_cast<size_t>(state)]++;
+    aiState[i] = state;
+    
+    if (previous == AIState::IDLE) {
+        unpark(i);
+        lastTickTime[i] = simTime;
+    }
+    if (state == AIState::IDLE) {
+        park(i);
+    }
+}
+
+void EnemyStore::park(size_t i) {
+    idleUntil[i] = simTime + IDLE_TIME;
+    timerSlot[i] = static_cast<std::int32_t>(idleTimers.size());
+    idleTimers.push_back(static_cast<std::uint32_t>(i));
+    siftTimer(timerSlot[i]);
+    
+    SquadBlackboard& board = squads[squad[i]];
+    idlePrev[i] = -1;
+    idleNext[i] = board.idleHead;
+    if (board.idleHead >= 0) idlePrev[board.idleHead] = static_cast<std::int32_t>(i);
+    board.idleHead = static_cast<std::int32_t>(i);
+}
+
+void EnemyStore::unpark(size_t i) {
+    size_t slot = timerSlot[i];
+    std::uint32_t moved = idleTimers.back();
+    idleTimers.pop_back();
+    if (moved != i) {
+        idleTimers[slot] = moved;
+        timerSlot[moved] = static_cast<std::int32_t>(slot);
+        siftTimer(slot);
+    }
+    timerSlot[i] = -1;
+    
+    if (idlePrev[i] >= 0) idleNext[idlePrev[i]] = idleNext[i];
+    else squads[squad[i]].idleHead = idleNext[i];
+    if (idleNext[i] >= 0) idlePrev[idleNext[i]] = idlePrev[i];
+    idleNext[i] = -1;
+    idlePrev[i] = -1;
+}
+
+void EnemyStore::siftTimer(size_t slot) {
+    // Up while due before the parent, otherwise down while due after a child
+    const std::uint32_t i = idleTimers[slot];
+    const double due = idleUntil[i];
+    while (slot > 0) {
+        size_t parent = (slot - 1) / 2;
+        if (idleUntil[idleTimers[parent]] <= due) break;
+        idleTimers[slot] = idleTimers[parent];
+        timerSlot[idleTimers[slot]] = static_cast<std::int32_t>(slot);
+        slot = parent;
+    }
+    const size_t count = idleTimers.size();
+    for (;;) {
+        size_t child = slot * 2 + 1;
+        if (child >= count) break;
+        if (child + 1 < count && idleUntil[idleTimers[child + 1]] < idleUntil[idleTimers[child]]) child++;
+        if (idleUntil[idleTimers[child]] >= due) break;
+        idleTimers[slot] = idleTimers[child];
+        timerSlot[idleTimers[slot]] = static_cast<std::int32_t>(slot);
+        slot = child;
+    }
+    idleTimers[slot] = i;
+    timerSlot[i] = static_cast<std::int32_t>(slot);
+}
+
+void EnemyStore::fireIdleTimers() {
+    while (!idleTimers.empty() && idleUntil[idleTimers[0]] <= simTime) {
+        size_t i = idleTimers[0];
+        setState(i, AIState::PATROL);
+        generatePatrolTarget(i);
+        
+        // The next tick only covers the time since the timer fired
+        lastTickTime[i] = idleUntil[i];
+    }
+}
+
+void EnemyStore::sortIntoBuckets() {
+    // Counting sort, stable so each bucket keeps schedule order
+    const size_t scheduled = tickList.size();
+    size_t fill[STATE_COUNT] = {};
+    for (std::uint32_t i : tickList) {
+        fill[static_cast<size_t>(aiState[i])]++;
+    }
+    bucketStart[0] = 0;
+    for (size_t s = 0; s < STATE_COUNT; s++) {
+        bucketStart[s + 1] = bucketStart[s] + fill[s];
+        fill[s] = bucketStart[s];
+    }
+    
+    bucketScratch.resize(scheduled);
+    bucketStepScratch.resize(scheduled);
+    for (size_t k = 0; k < scheduled; k++) {
+        size_t slot = fill[static_cast<size_t>(aiState[tickList[k]])]++;
+        bucketScratch[slot] = tickList[k];
+        bucketStepScratch[slot] = tickStep[k];
+    }
+    tickList.swap(bucketScratch);
+    tickStep.swap(bucketStepScratch);
+    nextState.resize(scheduled);
+}
+
+void EnemyStore::runBucket(AIState state) {
+    sf::Clock clock;
+    const size_t s = static_cast<size_t>(state);
+    
+    // Captures kept small enough for std::function to store inline
+    runParallel(bucketStart[s + 1] - bucketStart[s], [this, state](size_t begin, size_t end) {
+        const size_t first = bucketStart[static_cast<size_t>(state)];
+        switch (state) {
+            case AIState::PATROL: patrolLoop(first + begin, first + end); break;
+            case AIState::CHASE: chaseLoop(first + begin, first + end); break;
+            case AIState::ATTACK: attackLoop(first + begin, first + end); break;
+            default: break;
+        }
+    });
+    stateTimes[s] = clock.getElapsedTime();
+}
+
+void EnemyStore::applyTransitions() {
+    // Serial and in schedule order, since parking touches shared lists
+    for (size_t k = 0; k < tickList.size(); k++) {
+        size_t i = tickList[k];
+        if (nextState[k] == aiState[i]) continue;
+        setState(i, nextState[k]);
+        
+        // Giving up the chase starts a fresh patrol leg
+        if (nextState[k] == AIState::PATROL) {
+            generatePatrolTarget(i);
+        }
+    }
+}
+
+void EnemyStore::runParallel(size_t count, const std::function<void(size_t, size_t)>& fn) {
+    if (workers) {
+        workers->parallelFor(count, PARALLEL_GRAIN, fn);
+    } else if (count > 0) {
+        fn(0, count);
+    }
+}
+
+void EnemyStore::scheduleTicks(sf::Vector2f viewCenter) {
+    tickList.clear();
+    tickStep.clear();
+    
+    // Parked and dead enemies never think
+    if (!lod.enabled) {
+        for (size_t i = 0; i < size(); i++) {
+            if (thinks(i)) scheduleTick(i);
+        }
+        return;
+    }
+    
+    // Everything in view ticks every frame, outside the budget, and wakes up
+    grid.queryRadius(viewCenter, lod.fullRateRadius, lodScratch);
+    for (std::uint32_t i : lodScratch) {
+        if (lodTier[i] == LOD_SLEEP) wake(i);
+        lodTier[i] = LOD_FULL;
+        if (thinks(i)) scheduleTick(i);
+    }
+    
+    // So does anything fighting the player
+    for (std::uint32_t i : nearPlayer) {
+        if ((aiState[i] == AIState::CHASE || aiState[i] == AIState::ATTACK) && lastTickFrame[i] != frameCounter) {
+            if (lodTier[i] == LOD_SLEEP) wake(i);
+            lodTier[i] = LOD_FULL;
+            scheduleTick(i);
+        }
+    }
+    
+    // Reduced-rate enemies: walk the awake list round robin from where the
+    // last frame's budget ran out, at most one lap. Ones that miss out keep
+    // accumulating time; ones past the last radius fall asleep.
+    const float halfSq = lod.halfRateRadius * lod.halfRateRadius;
+    const float quarterSq = lod.quarterRateRadius * lod.quarterRateRadius;
+    const float eighthSq = lod.eighthRateRadius * lod.eighthRateRadius;
+    
+    size_t budget = lod.frameBudget;
+    size_t lap = awakeList.size();
+    for (size_t visited = 0; visited < lap && budget > 0 && !awakeList.empty(); visited++) {
+        if (lodCursor >= awakeList.size()) lodCursor = 0;
+        std::uint32_t i = awakeList[lodCursor];
+        if (lastTickFrame[i] == frameCounter) {
+            lodCursor++;
+            continue;
+        }
+        
+        float dx = posX[i] - viewCenter.x;
+        float dy = posY[i] - viewCenter.y;
+        float distSq = dx * dx + dy * dy;
+        if (distSq > eighthSq) {
+            sleep(i); // Moves another awake enemy into this slot
+            continue;
+        }
+        
+        std::uint8_t tier = distSq <= halfSq ? LOD_HALF : distSq <= quarterSq ? LOD_QUARTER : LOD_EIGHTH;
+        lodTier[i] = tier;
+        if (thinks(i) && frameCounter - lastTickFrame[i] >= (1u << tier)) {
+            scheduleTick(i);
+            budget--;
+        }
+        lodCursor++;
+    }
+}
+
+void EnemyStore::scheduleTick(size_t i) {
+    // Long sleeps catch up with one bounded step rather than a teleport
+    float step = static_cast<float>(simTime - lastTickTime[i]);
+    tickList.push_back(static_cast<std::uint32_t>(i));
+    tickStep.push_back(std::min(step, MAX_CATCHUP));
+    lastTickTime[i] = simTime;
+    lastTickFrame[i] = frameCounter;
+}
+
+void EnemyStore::wake(size_t i) {
+    awakeSlot[i] = static_cast<std::int32_t>(awakeList.size());
+    awakeList.push_back(static_cast<std::uint32_t>(i));
+    lodTier[i] = LOD_EIGHTH;
+}
+
+void EnemyStore::sleep(size_t i) {
+    std::int32_t slot = awakeSlot[i];
+    std::uint32_t moved = awakeList.back();
+    awakeList[slot] = moved;
+    awakeSlot[moved] = slot;
+    awakeList.pop_back();
+    awakeSlot[i] = -1;
+    lodTier[i] = LOD_SLEEP;
+}
+
+void EnemyStore::wakeArea(const sf::FloatRect& area) {
+    grid.queryAABB(area, lodScratch);
+    for (std::uint32_t i : lodScratch) {
+        if (lodTier[i] == LOD_SLEEP) {
+            wake(i);
+        }
+    }
+}
+
+void EnemyStore::measurePlayerDistance(sf::Vector2f playerPos) {
+    // Only enemies close enough to react get a real distance; the rest keep
+    // FAR_DISTANCE, so only last call's near set needs resetting
+    for (std::uint32_t i : nearPlayer) {
+        playerDistance[i] = FAR_DISTANCE;
+        playerDirX[i] = 0.0f;
+        playerDirY[i] = 0.0f;
+    }
+    grid.queryRadius(playerPos, senseRadius, nearPlayer);
+    
+    // Gather the near set into contiguous batches, run one vectorized pass
+    // for distance and chase direction, then scatter the results back
+    const size_t count = nearPlayer.size();
+    nearX.resize(count);
+    nearY.resize(count);
+    nearDistance.resize(count);
+    nearDirX.resize(count);
+    nearDirY.resize(count);
+    for (size_t k = 0; k < count; k++) {
+        nearX[k] = posX[nearPlayer[k]];
+        nearY[k] = posY[nearPlayer[k]];
+    }
+    
+    simd::directionTo(nearX.data(), nearY.data(), count, playerPos.x, playerPos.y,
+                      nearDirX.data(), nearDirY.data(), nearDistance.data());
+    
+    for (size_t k = 0; k < count; k++) {
+        std::uint32_t i = nearPlayer[k];
+        playerDistance[i] = nearDistance[k];
+        playerDirX[i] = nearDirX[k];
+        playerDirY[i] = nearDirY[k];
+    }
+}
+
+void EnemyStore::beginTick(size_t k) {
+    size_t i = tickList[k];
+    
+    // Visual feedback only lasts one frame
+    flash[i] = FLASH_NONE;
+    
+    // States that move set a desired velocity
+    velX[i] = 0.0f;
+    velY[i] = 0.0f;
+    nextState[k] = aiState[i];
+}
+
+void EnemyStore::patrolLoop(size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+        beginTick(k);
+        size_t i = tickList[k];
+        
+        // Move towards patrol target, and rest once it's reached
+        seek(i, patrolTargetX[i], patrolTargetY[i]);
+        float dx = patrolTargetX[i] - posX[i];
+        float dy = patrolTargetY[i] - posY[i];
+        if (dx * dx + dy * dy < 10.0f * 10.0f) {
+            nextState[k] = AIState::IDLE;
+        }
+        
+        // The squad has spotted the player
+        if (squads[squad[i]].threat > 0.0f) {
+            nextState[k] = AIState::CHASE;
+        }
+    }
+}
+
+void EnemyStore::chaseLoop(size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+        beginTick(k);
+        size_t i = tickList[k];
+        const EnemyArchetype& archetype = Archetypes::enemy(type[i]);
+        const SquadBlackboard& board = squads[squad[i]];
+        
+        // Lose interest once the squad's memory of the player has faded
+        if (board.threat <= 0.0f) {
+            nextState[k] = AIState::PATROL;
+            continue;
+        }
+        
+        // Around corners, follow the navigation field
+        sf::Vector2f step(0.0f, 0.0f);
+        if (dungeon && !dungeon->isVisible(posX[i], posY[i])) {
+            step = dungeon->getNavDirection(posX[i], posY[i]);
+        }
+        
+        if (step.x != 0.0f || step.y != 0.0f) {
+            velX[i] = step.x * archetype.speed;
+            velY[i] = step.y * archetype.speed;
+        } else if (board.playerVisible && playerDistance[i] <= 2.0f * FLANK_RADIUS) {
+            // Close in directly, along the direction from the distance pass
+            velX[i] = playerDirX[i] * archetype.speed;
+            velY[i] = playerDirY[i] * archetype.speed;
+        } else {
+            // Head for the last known position. Members still far off aim
+            // for their own slot around it, so the squad closes in from
+            // several sides instead of in a line.
+            float angle = squadSlot[i] * 2.39996f; // Golden angle spreads any member count evenly
+            seek(i, board.lastKnownX + std::cos(angle) * FLANK_RADIUS,
+                    board.lastKnownY + std::sin(angle) * FLANK_RADIUS);
+        }
+        
+        // Check if close enough to attack
+        if (playerDistance[i] <= archetype.attackRange) {
+            nextState[k] = AIState::ATTACK;
+        }
+    }
+}
+
+void EnemyStore::attackLoop(size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+        beginTick(k);
+        size_t i = tickList[k];
+        
+        // Stand and attack; go back to chasing if the player moved away
+        if (playerDistance[i] > Archetypes::enemy(type[i]).attackRange) {
+            nextState[k] = AIState::CHASE;
+        }
+    }
+}
+
+void EnemyStore::steer(size_t k) {
+    // Each worker thread keeps its own query buffer
+    thread_local std::vector<std::uint32_t> neighbours;
+    thread_local std::vector<std::pair<float, std::uint32_t>> nearest;
+    
+    const size_t i = tickList[k];
+    const float x = posX[i];
+    const float y = posY[i];
+    const float radius = crowd.neighbourRadius;
+    const float speed = Archetypes::enemy(type[i]).speed;
+    float vx = velX[i];
+    float vy = velY[i];
+    
+    // Separation and alignment over the nearest few of a bounded set of
+    // candidates, so a pile of k bodies costs O(k), not O(k^2)
+    grid.queryRadius(sf::Vector2f(x, y), radius, crowd.maxCandidates + 1, neighbours);
+    nearest.clear();
+    for (std::uint32_t j : neighbours) {
+        if (j == i) continue;
+        float dx = x - posX[j];
+        float dy = y - posY[j];
+        nearest.push_back(std::make_pair(dx * dx + dy * dy, j));
+    }
+    if (nearest.size() > crowd.maxNeighbours) {
+        std::nth_element(nearest.begin(), nearest.begin() + crowd.maxNeighbours, nearest.end());
+        nearest.resize(crowd.maxNeighbours);
+    }
+    
+    float separateX = 0.0f, separateY = 0.0f;
+    float alignX = 0.0f, alignY = 0.0f;
+    for (const auto& neighbour : nearest) {
+        std::uint32_t j = neighbour.second;
+        float dx = x - posX[j];
+        float dy = y - posY[j];
+        float distance = std::sqrt(neighbour.first);
+        if (distance < 0.001f) {
+            // Exactly stacked: split along an angle picked from the pair, in
+            // opposite directions for the two of them
+            std::uint32_t pairSeed = std::min<std::uint32_t>(i, j) * 2654435761u ^ std::max<std::uint32_t>(i, j);
+            float angle = (pairSeed % 628) * 0.01f;
+            float side = j < i ? 1.0f : -1.0f;
+            dx = std::cos(angle) * side;
+            dy = std::sin(angle) * side;
+            distance = 1.0f;
+        }
+        
+        // Unit push away, stronger the closer the neighbour is
+        float weight = (radius - std::min(distance, radius)) / (radius * distance);
+        separateX += dx * weight;
+        separateY += dy * weight;
+        alignX += velX[j];
+        alignY += velY[j];
+    }
+    size_t counted = nearest.size();
+    
+    // Separation comes first: the harder the crowd pushes, the less of the
+    // chase is left, so a pile spreads out instead of being pressed together
+    separateX *= crowd.separationWeight;
+    separateY *= crowd.separationWeight;
+    float crowding = std::min(1.0f, std::sqrt(separateX * separateX + separateY * separateY));
+    vx *= 1.0f - crowding;
+    vy *= 1.0f - crowding;
+    float steerVX = vx + separateX * speed;
+    float steerVY = vy + separateY * speed;
+    if (counted > 0 && (vx != 0.0f || vy != 0.0f)) {
+        steerVX += (alignX / counted - vx) * crowd.alignmentWeight;
+        steerVY += (alignY / counted - vy) * crowd.alignmentWeight;
+    }
+    
+    // Push off walls just beyond the body so crowds keep to the middle of corridors
+    if (dungeon) {
+        const float reach = ENEMY_SIZE * 0.5f + 6.0f;
+        const float push = crowd.wallWeight * speed;
+        if (dungeon->isWall(x - reach, y)) steerVX += push;
+        if (dungeon->isWall(x + reach, y)) steerVX -= push;
+        if (dungeon->isWall(x, y - reach)) steerVY += push;
+        if (dungeon->isWall(x, y + reach)) steerVY -= push;
+    }
+    
+    // Never faster than the enemy could move on its own
+    float length = std::sqrt(steerVX * steerVX + steerVY * steerVY);
+    if (length > speed) {
+        steerVX *= speed / length;
+        steerVY *= speed / length;
+    }
+    steerX[k] = steerVX;
+    steerY[k] = steerVY;
+}
+
+bool EnemyStore::blockedAt(float x, float y) const {
+    const float half = ENEMY_SIZE * 0.5f - 1.0f;
+    return dungeon->isWall(x - half, y - half) || dungeon->isWall(x + half, y - half) ||
+           dungeon->isWall(x - half, y + half) || dungeon->isWall(x + half, y + half);
+}
+
+void EnemyStore::integrate(size_t i, float deltaTime) {
+    float nextX = posX[i] + velX[i] * deltaTime;
+    float nextY = posY[i] + velY[i] * deltaTime;
+    if (!dungeon) {
+        posX[i] = nextX;
+        posY[i] = nextY;
+        return;
+    }
+    
+    // Move one axis at a time so enemies slide along walls. Enemies already
+    // overlapping a wall (spawned there, or a wall appeared) may move freely
+    // until they're out.
+    bool stuck = blockedAt(posX[i], posY[i]);
+    bool movedX = false, movedY = false;
+    if (stuck || !blockedAt(nextX, posY[i])) {
+        movedX = nextX != posX[i];
+        posX[i] = nextX;
+    }
+    if (stuck || !blockedAt(posX[i], nextY)) {
+        movedY = nextY != posY[i];
+        posY[i] = nextY;
+    }
+    
+    // A patrol target behind a wall would never be reached
+    if (aiState[i] == AIState::PATROL && !movedX && !movedY) {
+        generatePatrolTarget(i);
+    }
+}
+
+void EnemyStore::alert(size_t i) {
+    if (aiState[i] != AIState::DEAD) {
+        setState(i, AIState::CHASE);
+        squads[squad[i]].alertPending = true;
+    }
+}
+
+std::uint64_t EnemyStore::stateHash() const {
+    // FNV-1a over the fields that drive gameplay
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::uint32_t value) {
+        for (int byte = 0; byte < 4; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    
+    const size_t count = size();
+    for (size_t i = 0; i < count; i++) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &posX[i], sizeof(bits));
+        mix(bits);
+        std::memcpy(&bits, &posY[i], sizeof(bits));
+        mix(bits);
+        mix(static_cast<std::uint32_t>(health[i]));
+        mix(static_cast<std::uint32_t>(aiState[i]));
+        mix(rngState[i]);
+    }
+    return hash;
+}
+
+bool EnemyStore::indicesValid() const {
+    for (std::uint32_t i : nearPlayer) {
+        if (i >= size()) return false;
+    }
+    for (size_t slot = 0; slot < awakeList.size(); slot++) {
+        std::uint32_t i = awakeList[slot];
+        if (i >= size() || awakeSlot[i] != static_cast<std::int32_t>(slot)) return false;
+    }
+    for (size_t slot = 0; slot < idleTimers.size(); slot++) {
+        std::uint32_t i = idleTimers[slot];
+        if (i >= size() || timerSlot[i] != static_cast<std::int32_t>(slot)) return false;
+    }
+    return true;
+}
+
+void EnemyStore::queryRadius(sf::Vector2f center, float radius, std::vector<std::uint32_t>& out) const {
+    grid.queryRadius(center, radius, out);
+}
+
+void EnemyStore::queryAABB(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const {
+    grid.queryAABB(area, out);
+}
+
+void EnemyStore::seek(size_t i, float targetX, float targetY) {
+    float dx = targetX - posX[i];
+    float dy = targetY - posY[i];
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length == 0) return;
+    
+    const float speed = Archetypes::enemy(type[i]).speed;
+    velX[i] = dx / length * speed;
+    velY[i] = dy / length * speed;
+}
+
+void EnemyStore::generatePatrolTarget(size_t i) {
+    // Random patrol target within a reasonable range
+    float offsetX = (nextRandom(rngState[i]) % 20001) / 100.0f - 100.0f;
+    float offsetY = (nextRandom(rngState[i]) % 20001) / 100.0f - 100.0f;
+    patrolTargetX[i] = posX[i] + offsetX;
+    patrolTargetY[i] = posY[i] + offsetY;
+}
+
+int EnemyStore::strike(size_t i) {
+    const EnemyArchetype& archetype = Archetypes::enemy(type[i]);
+    if (simTime < attackReadyAt[i] || playerDistance[i] > archetype.attackRange) {
+        return 0;
+    }
+    
+    attackReadyAt[i] = simTime + archetype.attackCooldown;
+    flash[i] = FLASH_ATTACK;
+    return archetype.attack;
+}
+
+bool EnemyStore::markHit(size_t i, std::uint32_t attackId) {
+    if (lastHitBy[i] == attackId) return false;
+    lastHitBy[i] = attackId;
+    return true;
+}
+
+int EnemyStore::takeDamage(size_t i, int damage) {
+    int actualDamage = CombatSystem::mitigate(damage, Archetypes::enemy(type[i]).defense);
+    health[i] = std::max(0, health[i] - actualDamage);
+    flash[i] = FLASH_HIT;
+    
+    // Switch to chase state when damaged, and bring the squad along
+    if (aiState[i] != AIState::DEAD) {
+        setState(i, AIState::CHASE);
+        squads[squad[i]].alertPending = true;
+    }
+    
+    // Check if dead
+    if (health[i] <= 0) {
+        setState(i, AIState::DEAD);
+    }
+    return actualDamage;
+}
+
+int EnemyStore::getMaxHealth(size_t i) const {
+    return Archetypes::enemy(type[i]).health;
+}
+
+int EnemyStore::getExperienceReward(size_t i) const {
+    return Archetypes::enemy(type[i]).experience;
+}
+
+void EnemyStore::writeSnapshot(EnemySnapshot& out, const sf::FloatRect& area) {
+    out.x.clear();
+    out.y.clear();
+    out.prevX.clear();
+    out.prevY.clear();
+    out.color.clear();
+    out.detectionRange.clear();
+    out.healthFraction.clear();
+    
+    grid.queryAABB(area, snapshotScratch);
+    for (std::uint32_t i : snapshotScratch) {
+        if (aiState[i] == AIState::DEAD) continue;
+        const EnemyArchetype& archetype = Archetypes::enemy(type[i]);
+        out.x.push_back(posX[i]);
+        out.y.push_back(posY[i]);
+        out.prevX.push_back(prevX[i]);
+        out.prevY.push_back(prevY[i]);
+        out.color.push_back(flash[i] == FLASH_HIT ? sf::Color::White :
+                            flash[i] == FLASH_ATTACK ? sf::Color::Red : Archetypes::color(type[i]));
+        out.detectionRange.push_back(aiState[i] == AIState::CHASE ? archetype.detectionRange : 0.0f);
+        
+        // A tuning reload can lower the maximum below the current health
+        out.healthFraction.push_back(std::min(1.0f, static_cast<float>(health[i]) / archetype.health));
+    }
+}
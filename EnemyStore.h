@@ -0,0 +1,278 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "SpatialHash.h"
+
+class ThreadPool;
+class Dungeon;
+struct EnemySnapshot;
+
+enum class EnemyType : std::uint8_t {
+    GOBLIN,
+    ORC,
+    SKELETON
+};
+
+// AI States
+enum class AIState : std::uint8_t {
+    IDLE,
+    PATROL,
+    CHASE,
+    ATTACK,
+    DEAD
+};
+
+// AI level of detail. Radii are measured from the view center; enemies past
+// the last one fall asleep until they come into view or wakeArea() is called.
+// Per-frame cost follows the enemies near the view, not the store size.
+struct AILodSettings {
+    bool enabled = true;               // Off: every enemy ticks every frame
+    float fullRateRadius = 700.0f;     // Every frame; covers the visible screen
+    float halfRateRadius = 1200.0f;
+    float quarterRateRadius = 1800.0f;
+    float eighthRateRadius = 2600.0f;
+    size_t frameBudget = 2048;         // Reduced-rate updates per frame; full rate is never throttled
+};
+
+// Crowd steering applied on top of each enemy's desired velocity.
+// Neighbours come from the spatial grid, capped per enemy.
+struct CrowdSettings {
+    bool enabled = true;
+    float neighbourRadius = 36.0f;
+    size_t maxNeighbours = 8;          // Nearest ones that push and align
+    size_t maxCandidates = 16;         // Bodies looked at per enemy; bounds the work inside dense piles
+    float separationWeight = 2.0f;
+    float alignmentWeight = 0.3f;
+    float wallWeight = 0.8f;
+};
+
+// Shared perception for a group of enemies (a room, or a patch of open
+// floor). Refreshed once per tick from the squad's closest scheduled member;
+// members read it instead of sensing the player themselves.
+struct SquadBlackboard {
+    float lastKnownX = 0.0f, lastKnownY = 0.0f;
+    float threat = 0.0f;        // 1 while the player is seen, fading to 0 over THREAT_MEMORY
+    bool playerVisible = false;
+    bool alertPending = false;  // A member was hit or alerted; counts as a sighting
+    std::uint32_t members = 0;
+    std::uint32_t nextSlot = 0; // Flanking slots handed out to new members
+    std::int32_t idleHead = -1; // First parked (IDLE) member, linked through idleNext
+    
+    // Sensing pass bookkeeping
+    std::uint32_t sensedFrame = 0;
+    std::int32_t closest = -1;
+    float closestMargin = 0.0f;
+    double lastSensed = 0.0;
+};
+
+// All live enemies, stored as parallel arrays (structure of arrays) so the
+// per-frame kernels stream through only the fields they touch. Enemies are
+// addressed by index; removal swaps the last enemy into the freed slot, so
+// indices are only stable until the next remove().
+class EnemyStore {
+private:
+    // Transform
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> prevX, prevY; // At the start of the last update, for render interpolation
+    std::vector<std::uint32_t> movedList; // Whose prevX/Y lag behind: moved last update, or renamed by remove()
+    
+    // Stats, speeds and ranges are looked up in the type's archetype
+    std::vector<EnemyType> type;
+    std::vector<int> health;
+    
+    // Timers and AI
+    std::vector<double> attackReadyAt; // Sim time the next attack is allowed; no per-tick countdown
+    std::vector<std::uint32_t> lastHitBy; // Last attack that landed, so one attack hits once
+    std::vector<float> patrolTargetX, patrolTargetY;
+    std::vector<AIState> aiState;
+    std::vector<std::uint32_t> rngState;
+    std::vector<std::uint8_t> flash; // Visual feedback for this frame, see Flash
+    std::vector<std::int32_t> home;  // Spawn group set by the owner (room index), -1 if none
+    std::vector<std::uint32_t> squad;
+    std::vector<std::uint32_t> squadSlot; // Position around the target when flanking
+    
+    // Parked IDLE enemies: out of the tick schedule until their timer fires
+    // or their squad spots the player
+    std::vector<double> idleUntil;
+    std::vector<std::int32_t> timerSlot; // Position in idleTimers, -1 unless IDLE
+    std::vector<std::int32_t> idleNext, idlePrev; // Squad's parked list
+    
+    // AI level of detail
+    std::vector<std::uint8_t> lodTier; // See LodTier
+    std::vector<std::int32_t> awakeSlot; // Position in awakeList, -1 while asleep
+    std::vector<std::uint32_t> lastTickFrame;
+    std::vector<double> lastTickTime;
+    
+    // Written by the distance pass each update
+    std::vector<float> playerDistance;
+    std::vector<float> playerDirX, playerDirY; // Unit direction toward the player
+    
+    // Batch gathered from the grid for the SIMD distance kernel
+    std::vector<std::uint32_t> nearPlayer;
+    std::vector<float> nearX, nearY;
+    std::vector<float> nearDistance, nearDirX, nearDirY;
+    
+    // Proximity index over enemy positions, kept in step with the arrays
+    SpatialHash grid;
+    float senseRadius; // Farthest any enemy reacts to the player, from the archetypes
+    ThreadPool* workers; // Optional; null runs the update on the calling thread
+    const Dungeon* dungeon; // Walls and navigation; optional
+    CrowdSettings crowd;
+    
+    // Squads, keyed by home room or by coarse cell for enemies without one
+    std::vector<SquadBlackboard> squads;
+    std::vector<std::int32_t> squadOfHome; // -1 until a member joins
+    std::vector<std::int32_t> squadOfCell; // SQUAD_CELL grid over the world bounds
+    int squadCellsX, squadCellsY;
+    std::vector<std::uint32_t> sensedSquads;
+    std::vector<float> steerX, steerY; // Per scheduled enemy, from the steering pass
+    
+    // Tick scheduling
+    AILodSettings lod;
+    std::uint32_t frameCounter;
+    double simTime;
+    std::vector<std::uint32_t> awakeList; // Every enemy not asleep, in no particular order
+    size_t lodCursor; // Round-robin position in awakeList
+    std::vector<std::uint32_t> tickList; // Enemies that think this frame
+    std::vector<float> tickStep;         // Time each one catches up
+    std::vector<std::uint32_t> lodScratch;
+    std::vector<std::uint32_t> snapshotScratch;
+    std::vector<std::uint32_t> idleTimers; // Min-heap on idleUntil
+    
+    // State buckets: tickList is sorted by state each frame, and each state's
+    // range runs its own loop. Loops queue transitions in nextState; they're
+    // applied between the AI and movement passes.
+    static const size_t STATE_COUNT = 5;
+    size_t bucketStart[STATE_COUNT + 1];
+    std::vector<AIState> nextState; // Per scheduled enemy
+    std::vector<std::uint32_t> bucketScratch;
+    std::vector<float> bucketStepScratch;
+    size_t stateCounts[STATE_COUNT];
+    sf::Time stateTimes[STATE_COUNT];
+    
+    enum Flash : std::uint8_t {
+        FLASH_NONE,
+        FLASH_HIT,
+        FLASH_ATTACK
+    };
+    
+    // Value is log2 of the tick interval in frames
+    enum LodTier : std::uint8_t {
+        LOD_FULL,
+        LOD_HALF,
+        LOD_QUARTER,
+        LOD_EIGHTH,
+        LOD_SLEEP
+    };
+    
+    void measurePlayerDistance(sf::Vector2f playerPos);
+    void scheduleTicks(sf::Vector2f viewCenter);
+    void scheduleTick(size_t i);
+    bool thinks(size_t i) const { return aiState[i] != AIState::IDLE && aiState[i] != AIState::DEAD; }
+    void wake(size_t i);
+    void sleep(size_t i);
+    
+    std::uint32_t joinSquad(float x, float y, std::int32_t homeGroup);
+    size_t squadCellIndex(float x, float y) const;
+    void senseSquads(sf::Vector2f playerPos);
+    void runParallel(size_t count, const std::function<void(size_t, size_t)>& fn);
+    
+    // State machine. setState() keeps the counts, timers and parked lists in step.
+    void setState(size_t i, AIState state);
+    void park(size_t i);
+    void unpark(size_t i);
+    void fireIdleTimers();
+    void siftTimer(size_t slot);
+    void sortIntoBuckets();
+    void runBucket(AIState state);
+    void applyTransitions();
+    
+    // Parallel phase, per scheduled enemy: the state loops write the desired
+    // velocity, steering reads neighbours and writes steerX/Y, integrate moves
+    void beginTick(size_t k);
+    void patrolLoop(size_t begin, size_t end);
+    void chaseLoop(size_t begin, size_t end);
+    void attackLoop(size_t begin, size_t end);
+    void steer(size_t k);
+    void integrate(size_t i, float deltaTime);
+    bool blockedAt(float x, float y) const;
+    void generatePatrolTarget(size_t i);
+    void seek(size_t i, float targetX, float targetY);
+    
+public:
+    EnemyStore();
+    
+    size_t spawn(EnemyType enemyType, float x, float y, std::int32_t homeGroup = -1);
+    void remove(size_t i);
+    void clear();
+    void reserve(size_t capacity);
+    void setWorldBounds(float worldWidth, float worldHeight);
+    void setThreadPool(ThreadPool* pool) { workers = pool; }
+    
+    void setLodSettings(const AILodSettings& settings) { lod = settings; }
+    void setCrowdSettings(const CrowdSettings& settings) { crowd = settings; }
+    void setDungeon(const Dungeon* level) { dungeon = level; }
+    
+    // Batched per-frame update: distance to player, idle timers and tick
+    // scheduling (serial), then one AI loop per state and movement for the
+    // scheduled enemies across the worker pool, then state transitions and
+    // grid relinks (serial). The result is bit-identical for any thread count.
+    void update(float deltaTime, sf::Vector2f playerPos, sf::Vector2f viewCenter);
+    
+    // Room activation: sleeping enemies inside the area resume ticking
+    void wakeArea(const sf::FloatRect& area);
+    // Copies what the renderer draws of the live enemies in the area, found
+    // through the grid; reuses out's capacity
+    void writeSnapshot(EnemySnapshot& out, const sf::FloatRect& area);
+    
+    // Indices of enemies within range, via the spatial grid
+    void queryRadius(sf::Vector2f center, float radius, std::vector<std::uint32_t>& out) const;
+    void queryAABB(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+    
+    // Damage the enemy deals if its attack is ready and the player is in
+    // range, starting the cooldown; 0 otherwise
+    int strike(size_t i);
+    
+    // False if this attack already landed on the enemy. Attack ids start at 1.
+    bool markHit(size_t i, std::uint32_t attackId);
+    int takeDamage(size_t i, int damage); // Returns the damage after defense
+    void setHealth(size_t i, int value) { health[i] = value; }
+    void alert(size_t i); // Start chasing the player, along with the rest of the squad
+    
+    size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+    sf::Vector2f getPosition(size_t i) const { return sf::Vector2f(posX[i], posY[i]); }
+    float getPlayerDistance(size_t i) const { return playerDistance[i]; }
+    bool isDead(size_t i) const { return aiState[i] == AIState::DEAD; }
+    EnemyType getType(size_t i) const { return type[i]; }
+    std::int32_t getHome(size_t i) const { return home[i]; }
+    AIState getState(size_t i) const { return aiState[i]; }
+    int getHealth(size_t i) const { return health[i]; }
+    int getMaxHealth(size_t i) const;
+    int getExperienceReward(size_t i) const;
+    std::uint32_t getSquad(size_t i) const { return squad[i]; }
+    const SquadBlackboard& getSquadBlackboard(std::uint32_t id) const { return squads[id]; }
+    size_t getSquadCount() const { return squads.size(); }
+    size_t getSensedSquadCount() const { return sensedSquads.size(); } // Perception checks last tick
+    size_t getTickedCount() const { return tickList.size(); }
+    size_t getSleepingCount() const { return size() - awakeList.size(); }
+    size_t getStateCount(AIState state) const { return stateCounts[static_cast<size_t>(state)]; }
+    sf::Time getStateTime(AIState state) const { return stateTimes[static_cast<size_t>(state)]; } // Last update; IDLE is timer upkeep
+    
+    // Hash of positions, health, AI state and RNG, for determinism checks
+    std::uint64_t stateHash() const;
+    bool indicesValid() const; // Near set, awake list and idle timers all name live rows
+
+    
+    static const float ENEMY_SIZE;
+    static const float FAR_DISTANCE; // Reported for enemies outside the sensing radius
+    static const size_t PARALLEL_GRAIN; // Enemies per work chunk
+    static const float MAX_CATCHUP;     // Longest step a reduced-rate or woken enemy takes
+    static const float SQUAD_CELL;      // Squad grouping for enemies without a home room
+    static const float THREAT_MEMORY;   // Seconds a squad keeps hunting after losing sight
+    static const float FLANK_RADIUS;    // Members spread around the target this far out
+    static const float IDLE_TIME;       // Pause between patrol legs
+};
@@ -0,0 +1,30 @@
+#include "FrameScratch.h"
+
+FrameScratch::FrameScratch()
+    : rectanglesUsed(0)
+    , quads(sf::Quads) {
+}
+
+void FrameScratch::beginFrame() {
+    rectanglesUsed = 0;
+}
+
+sf::RectangleShape& FrameScratch::rectangle(sf::Vector2f size) {
+    if (rectanglesUsed == rectangles.size()) {
+        rectangles.emplace_back();
+    }
+    
+    sf::RectangleShape& shape = rectangles[rectanglesUsed++];
+    shape.setSize(size);
+    shape.setPosition(0, 0);
+    shape.setOrigin(0, 0);
+    shape.setFillColor(sf::Color::White);
+    shape.setOutlineThickness(0);
+    shape.setOutlineColor(sf::Color::White);
+    return shape;
+}
+
+sf::VertexArray& FrameScratch::quadBatch() {
+    quads.clear();
+    return quads;
+}
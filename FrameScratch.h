@@ -0,0 +1,25 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <deque>
+
+// Scratch space for render objects that only live for one frame (HUD bars,
+// panels, pixel text). Objects handed out are recycled at the next
+// beginFrame(), so after the first few frames nothing is allocated: shapes
+// keep their vertex buffers and the quad batch keeps its capacity.
+class FrameScratch {
+private:
+    std::deque<sf::RectangleShape> rectangles; // Deque, so handed-out references stay valid
+    size_t rectanglesUsed;
+    sf::VertexArray quads;
+    
+public:
+    FrameScratch();
+    
+    void beginFrame();
+    
+    // A rectangle reset to the given size, at the origin, white, no outline
+    sf::RectangleShape& rectangle(sf::Vector2f size);
+    
+    // Shared quad batch, emptied on every call; draw it before asking again
+    sf::VertexArray& quadBatch();
+};
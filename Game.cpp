@@ -1,24 +1,43 @@
 #include "Game.h"
+#include "AllocationCounter.h"
+#include "Archetypes.h"
 #include <iostream>
 #include <cmath>
 #include <map>
 #include <string>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <functional>
 
+const int Game::DEFAULT_TICK_RATE;
+const float Game::MAX_FRAME_TIME = 0.25f;
+const int Game::MAX_TICKS_PER_FRAME = 8;
+
+static const char* SAVE_FILE = "savegame.dat";
+static const char* TUNING_FILE = "tuning.txt";
 const int Game::WINDOW_WIDTH;
 const int Game::WINDOW_HEIGHT;
 
 Game::Game() 
     : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Dungeon Crawler", sf::Style::Close)
+    , sim(WINDOW_WIDTH, WINDOW_HEIGHT)
     , currentState(GameState::WELCOME)
-    , score(0)
-    , currentLevel(1)
-    , treasuresCollected(0)
-    , enemiesKilled(0)
-    , initialEnemyCount(0)
-    , isRunning(true) {
-    
-    window.setFramerateLimit(60);
+    , tickStep(1.0f / DEFAULT_TICK_RATE)
+    , accumulator(0.0f)
+    , isRunning(true)
+    , playbackFast(false)
+    , playbackDivergedAt(0)
+    , autoplay(false)
+    , autoplayRuns(0)
+    , snapshots(WINDOW_WIDTH, WINDOW_HEIGHT, Simulation::ENEMY_CAPACITY, Simulation::PROJECTILE_CAPACITY,
+                Simulation::MAX_POWERUPS)
+    , snapshotSerial(0)
+    , simRunning(false) {
+    
+    window.setVerticalSyncEnabled(true); // Frames are paced by the display, not by sleeping
+    Archetypes::loadTuning(TUNING_FILE);
     
     // Try to load font (optional - will use default if fails)
     if (!font.loadFromFile("arial.ttf")) {
@@ -31,43 +50,148 @@ Game::Game()
 
 Game::~Game() {
     // Smart pointers will automatically clean up
+    stopSimulation();
+    finishRecording();
 }
 
 void Game::run() {
+    if (playback && playbackFast) {
+        runReplayFast();
+        return;
+    }
+    
     std::cout << "Starting game loop..." << std::endl;
     
     while (window.isOpen() && isRunning) {
-        float deltaTime = clock.restart().asSeconds();
+        float deltaTime = std::min(clock.restart().asSeconds(), MAX_FRAME_TIME);
+        
+        // The simulation thread returns on its own when play ends (death,
+        // victory, the end of a replay); joining hands the state back
+        if (simulating() && !simRunning.load(std::memory_order_acquire)) {
+            stopSimulation();
+        }
         
+        keyboardLatch.latch(keyboard.sample(0));
         handleEvents();
         
-        // Update transition manager
-        if (transitionManager) {
-            transitionManager->update(deltaTime);
-            // Only use transition manager state if we're in a transition
-            if (transitionManager->isTransitioning()) {
-                currentState = transitionManager->getCurrentState();
+        if (!simulating()) {
+            if (autoplay) {
+                continueAutoplay();
+            }
+            
+            // Update transition manager
+            if (transitionManager) {
+                transitionManager->update(deltaTime);
+                // Only use transition manager state if we're in a transition
+                if (transitionManager->isTransitioning()) {
+                    currentState = transitionManager->getCurrentState();
+                }
+            }
+            
+            // Play runs on its own thread once the screen has settled; a
+            // fade into play still ticks here so the world moves under it
+            bool settled = !transitionManager || !transitionManager->isTransitioning();
+            if (currentState == GameState::PLAYING && settled) {
+                startSimulation();
+            } else if (currentState == GameState::PLAYING) {
+                float step;
+                advanceSimulation(deltaTime, step);
+                publishSnapshot(true, step);
+            } else {
+                accumulator = 0.0f;
             }
-        }
-        
-        if (currentState == GameState::PLAYING) {
-            update(deltaTime);
         }
         
         render();
-        
-        // Add a small delay to prevent excessive CPU usage
-        sf::sleep(sf::milliseconds(16)); // ~60 FPS
     }
     
+    stopSimulation();
     std::cout << "Game loop ended." << std::endl;
 }
 
+int Game::advanceSimulation(float frameTime, float& step) {
+    // Whole ticks only, so the simulation is the same at any frame rate.
+    // Playback takes its steps from the recording.
+    accumulator += frameTime;
+    step = tickStep;
+    int ticks = 0;
+    while (currentState == GameState::PLAYING) {
+        step = playback ? playback->getStep(sim.getTick() + 1) : tickStep;
+        if (accumulator < step) break;
+        
+        // Past the catch-up limit the game slows down instead of
+        // spending ever longer frames catching up
+        if (ticks == MAX_TICKS_PER_FRAME) {
+            accumulator = 0.0f;
+            break;
+        }
+        
+        sf::Clock tickClock;
+        update(step);
+        if (playback) {
+            tickTimes.push_back(tickClock.getElapsedTime().asSeconds() * 1000.0f);
+        }
+        updateReplay();
+        accumulator -= step;
+        ticks++;
+    }
+    return ticks;
+}
+
+void Game::startSimulation() {
+    if (simulating()) return;
+    
+    // The renderer starts from the current state, not whatever it drew last
+    publishSnapshot(false, tickStep);
+    simRunning.store(true, std::memory_order_release);
+    simThread = std::thread(&Game::simulationLoop, this);
+}
+
+void Game::stopSimulation() {
+    if (!simulating()) return;
+    simRunning.store(false, std::memory_order_release);
+    simThread.join();
+}
+
+void Game::simulationLoop() {
+    // Until this returns, the ticks own the world; the main thread only
+    // reads the snapshots published here
+    sf::Clock frameClock;
+    while (simRunning.load(std::memory_order_acquire)) {
+        float elapsed = std::min(frameClock.restart().asSeconds(), MAX_FRAME_TIME);
+        float step;
+        if (advanceSimulation(elapsed, step) > 0) {
+            publishSnapshot(true, step);
+        }
+        if (currentState != GameState::PLAYING) break;
+        
+        // Sleep until the next tick is due; rendering keeps interpolating
+        float wait = step - accumulator;
+        if (wait > 0.0f) {
+            sf::sleep(sf::seconds(wait));
+        }
+    }
+    simRunning.store(false, std::memory_order_release);
+}
+
+void Game::publishSnapshot(bool live, float step) {
+    WorldSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.serial = ++snapshotSerial;
+    snapshot.live = live;
+    snapshot.step = step;
+    snapshot.leftover = accumulator;
+    snapshot.publishedAt = std::chrono::steady_clock::now();
+    
+    sim.writeSnapshot(snapshot);
+    snapshots.publish();
+}
+
 void Game::handleEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
         switch (event.type) {
             case sf::Event::Closed:
+                stopSimulation();
                 window.close();
                 isRunning = false;
                 break;
@@ -79,11 +203,22 @@ void Game::handleEvents() {
                 break;
                 
             case sf::Event::KeyPressed:
+                // During play only the keys that leave it (pause, save,
+                // load) do anything; the simulation stops before they run
+                if (simulating()) {
+                    sf::Keyboard::Key key = event.key.code;
+                    if (key != sf::Keyboard::Escape && key != sf::Keyboard::F5 && key != sf::Keyboard::F9) {
+                        break;
+                    }
+                    stopSimulation();
+                }
                 handleKeyPress(event.key.code);
                 break;
                 
             case sf::Event::MouseButtonPressed:
-                handleMouseClick(event.mouseButton.x, event.mouseButton.y);
+                if (!simulating()) { // Nothing is clickable in play
+                    handleMouseClick(event.mouseButton.x, event.mouseButton.y);
+                }
                 break;
                 
             default:
@@ -148,6 +283,10 @@ void Game::handleKeyPress(sf::Keyboard::Key key) {
         case GameState::PLAYING:
             if (key == sf::Keyboard::Escape) {
                 currentState = GameState::PAUSED;
+            } else if (key == sf::Keyboard::F5) {
+                saveGame();
+            } else if (key == sf::Keyboard::F9) {
+                loadGame();
             }
             break;
             
@@ -159,10 +298,7 @@ void Game::handleKeyPress(sf::Keyboard::Key key) {
                 resetGame(); // Restart
             } else if (key == sf::Keyboard::Q) {
                 currentState = GameState::WELCOME; // Quit to menu
-                currentLevel = 1;
-                treasuresCollected = 0;
-                enemiesKilled = 0;
-                score = 0;
+                sim.resetProgress();
             }
             break;
             
@@ -181,9 +317,7 @@ void Game::handleKeyPress(sf::Keyboard::Key key) {
             } else if (key == sf::Keyboard::Escape) {
                 currentState = GameState::WELCOME;
                 // Reset to level 1
-                currentLevel = 1;
-                treasuresCollected = 0;
-                enemiesKilled = 0;
+                sim.resetProgress();
             }
             break;
     }
@@ -312,10 +446,7 @@ void Game::handleMouseClick(int x, int y) {
                     std::cout << "Quit to Menu button clicked!" << std::endl;
                     currentState = GameState::WELCOME;
                     // Reset game state
-                    currentLevel = 1;
-                    treasuresCollected = 0;
-                    enemiesKilled = 0;
-                    score = 0;
+                    sim.resetProgress();
                 }
             }
             break;
@@ -331,9 +462,7 @@ void Game::handleMouseClick(int x, int y) {
                     std::cout << "Main Menu button clicked!" << std::endl;
                     currentState = GameState::WELCOME;
                     // Reset to level 1
-                    currentLevel = 1;
-                    treasuresCollected = 0;
-                    enemiesKilled = 0;
+                    sim.resetProgress();
                 }
             }
             break;
@@ -350,9 +479,7 @@ void Game::handleMouseClick(int x, int y) {
                     std::cout << "Menu button clicked!" << std::endl;
                     currentState = GameState::WELCOME;
                     // Reset to level 1
-                    currentLevel = 1;
-                    treasuresCollected = 0;
-                    enemiesKilled = 0;
+                    sim.resetProgress();
                 }
             }
             break;
@@ -360,82 +487,26 @@ void Game::handleMouseClick(int x, int y) {
 }
 
 void Game::update(float deltaTime) {
-    if (player && player->isAlive()) {
-        player->update(deltaTime);
-        
-        // Proper collision detection with boundaries
-        sf::Vector2f newPos = player->getPosition();
-        sf::FloatRect playerBounds = player->getBounds();
-        
-        // Store previous position before movement
-        static sf::Vector2f previousPosition = newPos;
-        static bool firstUpdate = true;
-        
-        if (!firstUpdate) {
-            // Check collision with walls using player bounds
-            if (checkWallCollision(newPos, sf::Vector2f(playerBounds.width, playerBounds.height))) {
-                // Revert to previous position
-                player->setPosition(previousPosition);
-            } else {
-                // Update previous position if no collision
-                previousPosition = newPos;
-            }
-        } else {
-            previousPosition = newPos;
-            firstUpdate = false;
-        }
-        
-        // Check treasure collection
-        TileType currentTile = dungeon->getTileType(newPos.x, newPos.y);
-        if (currentTile == TileType::TREASURE) {
-            // Collect treasure
-            score += 500;
-            treasuresCollected++;
-            player->gainExperience(50);
-            
-            std::cout << "Treasure collected! Total: " << treasuresCollected << std::endl;
-            
-            // Remove treasure (convert to floor)
-            dungeon->setTileTypeAt(newPos.x, newPos.y, TileType::FLOOR);
-            
-            if (camera) {
-                camera->shake(3.0f, 0.3f);
-            }
-        }
-        
-        // Update camera to follow player
-        if (camera) {
-            camera->update(player->getPosition(), deltaTime);
-        }
-        
-        // Update enemies
-        updateEnemies(deltaTime);
-        
-        // Update power-ups
-        updatePowerUps(deltaTime);
-        
-        // Check victory conditions for level progression
-        checkVictoryConditions();
-        
-        // Check if player is dead
-        if (!player->isAlive()) {
-            currentState = GameState::GAME_OVER;
-        }
+    // Input is read here and nowhere else in the tick
+    std::uint32_t tick = sim.getTick() + 1;
+    InputCommand command = input ? input->sample(tick) : keyboardLatch.sample(tick);
+    if (recording) {
+        recording->record(deltaTime, command);
     }
     
-    // Update transition manager
-    if (transitionManager) {
-        transitionManager->update(deltaTime);
-        if (transitionManager->shouldChangeState()) {
-            currentState = transitionManager->getTargetState();
-        }
+    sim.tick(deltaTime, command);
+    if (sim.getState() != GameState::PLAYING) {
+        currentState = sim.getState();
     }
 }
 
 void Game::render() {
     window.clear(sf::Color(176, 224, 230)); // Light teal background
+    scratch.beginFrame();
     
-    switch (currentState) {
+    // While the simulation thread runs, the state is its to change
+    GameState shown = simulating() ? GameState::PLAYING : currentState;
+    switch (shown) {
         case GameState::WELCOME:
             renderWelcomeScreen();
             break;
@@ -468,37 +539,14 @@ void Game::render() {
         }
         
         case GameState::PLAYING: {
-            // Set camera view
-            if (camera) {
-                camera->setView(window);
-            }
-            
-            // Render game world
-            if (dungeon) {
-                dungeon->render(window, camera ? camera->getView() : window.getDefaultView());
-            }
-            
-            if (player) {
-                player->render(window);
-            }
-            
-            // Render enemies
-            for (auto& enemy : enemies) {
-                if (enemy && enemy->isAlive()) {
-                    enemy->render(window);
-                }
-            }
-            
-            // Render power-ups
-            for (auto& powerUp : powerUps) {
-                if (powerUp && !powerUp->isCollected()) {
-                    powerUp->render(window);
-                }
-            }
+            WorldSnapshot& snapshot = snapshots.read();
+            worldRenderer.render(window, snapshot);
             
             // Reset to default view for UI
             window.setView(window.getDefaultView());
-            renderUI();
+            if (snapshot.hasPlayer) {
+                renderUI(snapshot.hud);
+            }
             break;
         }
         
@@ -529,8 +577,6 @@ void Game::render() {
 void Game::initializeGame() {
     std::cout << "Initializing game..." << std::endl;
     // Initialize game systems
-    camera = std::make_unique<Camera>(WINDOW_WIDTH, WINDOW_HEIGHT);
-    dungeon = std::make_unique<Dungeon>(60, 45); // Compact but complex dungeon
     userManager = std::make_unique<UserManager>();
     transitionManager = std::make_unique<TransitionManager>(WINDOW_WIDTH, WINDOW_HEIGHT);
     
@@ -543,255 +589,63 @@ void Game::initializeGame() {
 
 void Game::resetGame() {
     std::cout << "Resetting game..." << std::endl;
+    finishRecording(); // A new run ends the one being recorded
     
-    // Reset level progress (only when starting new game, not between levels)
-    if (currentState != GameState::VICTORY) {
-        currentLevel = 1;
-        treasuresCollected = 0;
-        enemiesKilled = 0;
-        score = 0;
-    }
-    
-    // Generate new level
-    generateLevel();
-    
-    // Create player at spawn point
-    sf::Vector2f spawnPoint = dungeon->getPlayerSpawn();
-    std::cout << "Player spawn: " << spawnPoint.x << ", " << spawnPoint.y << std::endl;
-    player = std::make_unique<Player>(spawnPoint.x, spawnPoint.y);
-    
-    // Clear and regenerate enemies
-    enemies.clear();
-    int enemyCount = 6 + (currentLevel - 1) * 2; // Scale with level: 6, 8, 10, 12...
-    enemyCount = std::min(enemyCount, 12); // Cap at 12 enemies
-    
-    std::vector<sf::Vector2f> enemySpawns = dungeon->getEnemySpawns(enemyCount);
-    initialEnemyCount = enemySpawns.size(); // Track actual enemy count
-    
-    std::cout << "Generated " << initialEnemyCount << " enemies for level " << currentLevel << std::endl;
-    for (const auto& spawn : enemySpawns) {
-        // Randomly choose enemy type
-        EnemyType type = static_cast<EnemyType>(rand() % 3);
-        enemies.push_back(std::make_unique<Enemy>(type, spawn.x, spawn.y));
+    unsigned int seed = playback ? playback->getSeed() : std::random_device{}();
+    if (!recordPath.empty() && !playback) {
+        recording = std::make_unique<Replay>(seed, Archetypes::tableHash());
     }
-    
-    // Generate power-ups
-    generatePowerUps();
-}
-
-void Game::generateLevel() {
-    if (dungeon) {
-        dungeon->generate();
-    }
-}
-
-void Game::checkVictoryConditions() {
-    // Clear and consistent victory conditions:
-    // 1. Collect at least 2 treasures (minimum progress requirement)
-    // 2. AND defeat at least 50% of enemies OR collect ALL treasures
-    
-    int totalTreasures = getTotalTreasures();
-    int totalEnemies = initialEnemyCount;
-    
-    bool minimumTreasures = (treasuresCollected >= 2);
-    bool allTreasuresCollected = (treasuresCollected >= totalTreasures);
-    bool majorityEnemiesKilled = (enemiesKilled >= totalEnemies / 2);
-    
-    // Victory condition: minimum treasures AND (majority enemies killed OR all treasures)
-    bool levelComplete = minimumTreasures && (majorityEnemiesKilled || allTreasuresCollected);
-    
-    if (levelComplete) {
-        std::cout << "=== LEVEL " << currentLevel << " COMPLETED! ===" << std::endl;
-        std::cout << "Treasures collected: " << treasuresCollected << "/" << totalTreasures << std::endl;
-        std::cout << "Enemies defeated: " << enemiesKilled << "/" << totalEnemies << std::endl;
-        std::cout << "Victory condition met!" << std::endl;
-        
-        currentLevel++;
-        currentState = GameState::VICTORY;
-    }
-}
-
-int Game::getTotalTreasures() {
-    // Count treasures in current dungeon
-    int totalTreasures = 0;
-    if (dungeon) {
-        // Estimate based on room count (roughly 30% of rooms have treasure, minimum 3)
-        totalTreasures = std::max(3, (int)(dungeon->getRoomCount() * 0.3f));
-    }
-    return totalTreasures;
-}
-
-int Game::getInitialEnemyCount() {
-    return initialEnemyCount;
+    sim.startRun(seed);
 }
 
 void Game::nextLevel() {
-    std::cout << "Advancing to level " << currentLevel << "!" << std::endl;
-    
-    // Reset level stats
-    treasuresCollected = 0;
-    enemiesKilled = 0;
-    
-    // Generate new level with increased difficulty
-    generateLevel();
-    
-    // Reset player position
-    if (dungeon && player) {
-        sf::Vector2f spawnPoint = dungeon->getPlayerSpawn();
-        player->setPosition(spawnPoint);
-    }
-    
-    // Regenerate enemies with increased difficulty
-    enemies.clear();
-    powerUps.clear(); // Clear old power-ups
-    if (dungeon) {
-        int enemyCount = 6 + (currentLevel - 1) * 2; // Scale with level: 6, 8, 10, 12...
-        enemyCount = std::min(enemyCount, 14); // Cap at 14 enemies
-        
-        std::vector<sf::Vector2f> enemySpawns = dungeon->getEnemySpawns(enemyCount);
-        initialEnemyCount = enemySpawns.size(); // Track actual enemy count
-        
-        std::cout << "Generated " << initialEnemyCount << " enemies for level " << currentLevel << std::endl;
-        
-        for (const auto& spawn : enemySpawns) {
-            EnemyType type = static_cast<EnemyType>(rand() % 3);
-            enemies.push_back(std::make_unique<Enemy>(type, spawn.x, spawn.y));
-        }
-    }
+    sim.nextLevel();
     
     // Resume playing
     currentState = GameState::PLAYING;
 }
 
-void Game::updateEnemies(float deltaTime) {
-    for (auto it = enemies.begin(); it != enemies.end();) {
-        if ((*it)->isDead()) {
-            // Award experience for killing enemy
-            if (player) {
-                player->gainExperience((*it)->getExperienceReward());
-                score += 100;
-                enemiesKilled++;
-                std::cout << "Enemy killed! Total: " << enemiesKilled << std::endl;
-            }
-            it = enemies.erase(it);
-        } else {
-            if (player) {
-                (*it)->update(deltaTime, *player);
-                
-                // Check for combat
-                float distance = std::sqrt(std::pow((*it)->getPosition().x - player->getPosition().x, 2) + 
-                                         std::pow((*it)->getPosition().y - player->getPosition().y, 2));
-                
-                // Enemy attacks player
-                if (distance <= 40.0f) { // Attack range
-                    (*it)->attack(*player);
-                }
-                
-                // Player attacks enemy when attacking and in range
-                if (player->getIsAttacking() && distance <= 60.0f) {
-                    int damage = player->getEffectiveAttack();
-                    (*it)->takeDamage(damage);
-                    
-                    std::cout << "Player attacked enemy for " << damage << " damage! Enemy health: " << (*it)->getStats().health << "/" << (*it)->getStats().maxHealth << std::endl;
-                    
-                    // Camera shake on hit
-                    if (camera) {
-                        camera->shake(5.0f, 0.2f);
-                    }
-                }
-            }
-            ++it;
-        }
-    }
+void Game::saveGame() {
+    sim.save(SAVE_FILE);
 }
 
-void Game::generatePowerUps() {
-    powerUps.clear();
-    
-    if (!dungeon) return;
-    
-    // Generate 3-5 power-ups per level
-    int powerUpCount = 3 + (rand() % 3);
-    
-    for (int i = 0; i < powerUpCount; i++) {
-        // Get random empty position
-        sf::Vector2f pos;
-        int attempts = 0;
-        do {
-            pos.x = 50 + rand() % (dungeon->getWidth() * 20 - 100);
-            pos.y = 50 + rand() % (dungeon->getHeight() * 20 - 100);
-            attempts++;
-        } while (dungeon->isWall(pos.x, pos.y) && attempts < 50);
-        
-        if (attempts < 50) {
-            // Random power-up type
-            PowerUpType type = static_cast<PowerUpType>(rand() % 4);
-            powerUps.push_back(std::make_unique<PowerUp>(type, pos.x, pos.y));
-        }
-    }
+void Game::loadGame() {
+    if (playback) return;
     
-    std::cout << "Generated " << powerUps.size() << " power-ups for level " << currentLevel << std::endl;
-}
-
-void Game::updatePowerUps(float deltaTime) {
-    if (!player) return;
-    
-    for (auto it = powerUps.begin(); it != powerUps.end();) {
-        if ((*it)->checkCollision(player->getPosition(), Player::PLAYER_SIZE)) {
-            // Player collected power-up
-            PowerUpType type = (*it)->getType();
-            int value = (*it)->getEffectValue();
-            float duration = (*it)->getEffectDuration();
-            
-            player->applyPowerUp(static_cast<int>(type), value, duration);
-            
-            // Visual/audio feedback
-            std::string powerUpName;
-            switch (type) {
-                case PowerUpType::HEALTH_POTION: powerUpName = "Health Potion"; break;
-                case PowerUpType::DAMAGE_BOOST: powerUpName = "Damage Boost"; break;
-                case PowerUpType::SPEED_BOOST: powerUpName = "Speed Boost"; break;
-                case PowerUpType::ARMOR_BOOST: powerUpName = "Armor Boost"; break;
-            }
-            
-            std::cout << "Collected " << powerUpName << "!" << std::endl;
-            
-            it = powerUps.erase(it);
-        } else {
-            ++it;
-        }
+    // A loaded save can't be reproduced from the recording's seed
+    if (sim.load(SAVE_FILE) && recording) {
+        std::cout << "Loading a save ends the replay recording" << std::endl;
+        finishRecording();
     }
 }
 
-void Game::renderUI() {
-    if (!player) return;
-    
-    Stats stats = player->getStats();
+void Game::renderUI(const HudSnapshot& hud) {
+    const Stats& stats = hud.stats;
     
     // Health bar
-    sf::RectangleShape healthBarBg(sf::Vector2f(200, 20));
+    sf::RectangleShape& healthBarBg = scratch.rectangle(sf::Vector2f(200, 20));
     healthBarBg.setPosition(10, 10);
     healthBarBg.setFillColor(sf::Color::Red);
     
-    sf::RectangleShape healthBar(sf::Vector2f(200 * stats.health / stats.maxHealth, 20));
+    sf::RectangleShape& healthBar = scratch.rectangle(sf::Vector2f(200 * stats.health / stats.maxHealth, 20));
     healthBar.setPosition(10, 10);
     healthBar.setFillColor(sf::Color::Green);
     
     // Level indicator (colored rectangles)
     for (int i = 0; i < stats.level; i++) {
-        sf::RectangleShape levelIndicator(sf::Vector2f(15, 15));
+        sf::RectangleShape& levelIndicator = scratch.rectangle(sf::Vector2f(15, 15));
         levelIndicator.setPosition(10 + i * 20, 40);
         levelIndicator.setFillColor(sf::Color::Yellow);
         window.draw(levelIndicator);
     }
     
     // Experience bar
-    sf::RectangleShape expBarBg(sf::Vector2f(200, 10));
+    sf::RectangleShape& expBarBg = scratch.rectangle(sf::Vector2f(200, 10));
     expBarBg.setPosition(10, 65);
     expBarBg.setFillColor(sf::Color::Blue);
     
     int expNeeded = stats.level * 100;
-    sf::RectangleShape expBar(sf::Vector2f(200 * stats.experience / expNeeded, 10));
+    sf::RectangleShape& expBar = scratch.rectangle(sf::Vector2f(200 * stats.experience / expNeeded, 10));
     expBar.setPosition(10, 65);
     expBar.setFillColor(sf::Color::Cyan);
     
@@ -801,27 +655,30 @@ void Game::renderUI() {
     window.draw(expBar);
     
     // Level progression info (top right)
-    sf::RectangleShape infoBg(sf::Vector2f(250, 120));
+    sf::RectangleShape& infoBg = scratch.rectangle(sf::Vector2f(250, 120));
     infoBg.setPosition(WINDOW_WIDTH - 260, 10);
     infoBg.setFillColor(sf::Color(30, 30, 30, 180));
     infoBg.setOutlineThickness(2);
     infoBg.setOutlineColor(sf::Color(100, 100, 100));
     window.draw(infoBg);
     
+    // Formatted into a stack buffer; the HUD runs every frame
+    char line[64];
+    
     // Current level
-    std::string levelText = "LEVEL " + std::to_string(currentLevel);
-    drawSimpleText(window, levelText, WINDOW_WIDTH - 250, 20);
+    std::snprintf(line, sizeof(line), "LEVEL %d", hud.level);
+    drawSimpleText(window, line, WINDOW_WIDTH - 250, 20);
     
     // Treasures collected
-    std::string treasureText = "Treasures: " + std::to_string(treasuresCollected) + "/" + std::to_string(getTotalTreasures());
-    drawSimpleText(window, treasureText, WINDOW_WIDTH - 250, 40);
+    std::snprintf(line, sizeof(line), "Treasures: %d/%d", hud.treasuresCollected, hud.totalTreasures);
+    drawSimpleText(window, line, WINDOW_WIDTH - 250, 40);
     
     // Enemies defeated
-    std::string enemyText = "Enemies: " + std::to_string(enemiesKilled) + "/" + std::to_string(initialEnemyCount);
-    drawSimpleText(window, enemyText, WINDOW_WIDTH - 250, 60);
+    std::snprintf(line, sizeof(line), "Enemies: %d/%d", hud.enemiesKilled, hud.initialEnemyCount);
+    drawSimpleText(window, line, WINDOW_WIDTH - 250, 60);
     
     // Victory requirements - more prominent
-    sf::RectangleShape objectiveBg(sf::Vector2f(240, 60));
+    sf::RectangleShape& objectiveBg = scratch.rectangle(sf::Vector2f(240, 60));
     objectiveBg.setPosition(WINDOW_WIDTH - 250, 80);
     objectiveBg.setFillColor(sf::Color(0, 100, 150, 200));
     objectiveBg.setOutlineThickness(2);
@@ -833,17 +690,17 @@ void Game::renderUI() {
     drawSimpleText(window, "- Kill 50% of enemies", WINDOW_WIDTH - 245, 120);
     
     // Show current progress toward objectives
-    bool treasureObjective = treasuresCollected >= 2;
-    bool enemyObjective = (initialEnemyCount > 0) && (enemiesKilled >= initialEnemyCount / 2);
+    bool treasureObjective = hud.treasuresCollected >= 2;
+    bool enemyObjective = (hud.initialEnemyCount > 0) && (hud.enemiesKilled >= hud.initialEnemyCount / 2);
     
-    std::string treasureStatus = treasureObjective ? "[DONE]" : "[NEED MORE]";
-    std::string enemyStatus = enemyObjective ? "[DONE]" : "[NEED MORE]";
+    const char* treasureStatus = treasureObjective ? "[DONE]" : "[NEED MORE]";
+    const char* enemyStatus = enemyObjective ? "[DONE]" : "[NEED MORE]";
     
     drawSimpleText(window, treasureStatus, WINDOW_WIDTH - 100, 105);
     drawSimpleText(window, enemyStatus, WINDOW_WIDTH - 100, 120);
     
     // Attack instructions and player stats
-    sf::RectangleShape controlsBg(sf::Vector2f(250, 100));
+    sf::RectangleShape& controlsBg = scratch.rectangle(sf::Vector2f(250, 100));
     controlsBg.setPosition(10, 90);
     controlsBg.setFillColor(sf::Color(50, 50, 50, 180));
     controlsBg.setOutlineThickness(2);
@@ -852,42 +709,184 @@ void Game::renderUI() {
     
     drawSimpleText(window, "CONTROLS:", 20, 100);
     drawSimpleText(window, "WASD - Move", 20, 115);
-    drawSimpleText(window, "SPACE - Attack (near enemies)", 20, 130);
+    drawSimpleText(window, "SPACE - Attack, F - Throw", 20, 130);
     drawSimpleText(window, "ESC - Pause Menu", 20, 145);
     
     // Player attack power and status
-    std::string attackText = "Attack: " + std::to_string(player->getEffectiveAttack());
-    drawSimpleText(window, attackText, 20, 165);
+    std::snprintf(line, sizeof(line), "Attack: %d", hud.effectiveAttack);
+    drawSimpleText(window, line, 20, 165);
     
     // Attack readiness indicator
-    if (player->getIsAttacking()) {
+    if (hud.attacking) {
         drawSimpleText(window, "ATTACKING!", 150, 165);
     } else {
         drawSimpleText(window, "Ready to attack", 150, 165);
     }
 }
 
-bool Game::checkWallCollision(sf::Vector2f position, sf::Vector2f size) {
-    if (!dungeon) return false;
-    
-    // Check all four corners of the player
-    sf::Vector2f topLeft = position - size / 2.0f;
-    sf::Vector2f topRight = sf::Vector2f(position.x + size.x / 2.0f, position.y - size.y / 2.0f);
-    sf::Vector2f bottomLeft = sf::Vector2f(position.x - size.x / 2.0f, position.y + size.y / 2.0f);
-    sf::Vector2f bottomRight = position + size / 2.0f;
-    
-    return dungeon->isWall(topLeft.x, topLeft.y) ||
-           dungeon->isWall(topRight.x, topRight.y) ||
-           dungeon->isWall(bottomLeft.x, bottomLeft.y) ||
-           dungeon->isWall(bottomRight.x, bottomRight.y);
-}
-
 void Game::transitionToState(GameState newState) {
     if (transitionManager) {
         transitionManager->startTransition(currentState, newState);
     }
 }
 
+void Game::setInputSource(std::unique_ptr<InputSource> source) {
+    input = std::move(source); // Null falls back to the latched keyboard
+}
+
+void Game::setTickRate(int ticksPerSecond) {
+    tickStep = 1.0f / std::max(1, ticksPerSecond);
+    std::cout << "Simulating at " << std::max(1, ticksPerSecond) << " ticks per second" << std::endl;
+}
+
+void Game::recordReplays(const std::string& path) {
+    recordPath = path;
+    std::cout << "Recording runs to " << path << std::endl;
+}
+
+bool Game::playReplay(const std::string& path, bool fast) {
+    auto loaded = std::make_unique<Replay>();
+    if (!loaded->load(path)) {
+        return false;
+    }
+    
+    // Stats come from the archetypes, so other tuning plays a different game
+    if (loaded->getTuningHash() != Archetypes::tableHash()) {
+        std::cout << "Replay " << path << " was recorded with different tuning (" << std::hex
+                  << loaded->getTuningHash() << ", now " << Archetypes::tableHash() << std::dec
+                  << "); restore the tuning.txt it was recorded with" << std::endl;
+        return false;
+    }
+    
+    std::cout << "Playing replay " << path << ": " << loaded->getTickCount() << " ticks, seed "
+              << loaded->getSeed() << (fast ? ", headless" : "") << std::endl;
+    finishRecording();
+    playback = std::move(loaded);
+    playbackFast = fast;
+    playbackDivergedAt = 0;
+    tickTimes.clear();
+    tickTimes.reserve(playback->getTickCount());
+    setInputSource(std::make_unique<RecordedInput>(playback->getCommands()));
+    sim.setTuningReload(false); // Edits to tuning.txt wait until the playback ends
+    
+    // Straight into the run; menus and logins aren't part of the recording
+    currentState = GameState::PLAYING;
+    resetGame();
+    return true;
+}
+
+void Game::updateReplay() {
+    if (!recording && !playback) return;
+    
+    // A tuning reload mid-run can't be played back under the recorded tuning
+    if (recording && recording->getTuningHash() != Archetypes::tableHash()) {
+        std::cout << "Tuning changed; that ends the replay recording" << std::endl;
+        finishRecording();
+    }
+    
+    if (sim.getTick() % Replay::CHECKPOINT_INTERVAL == 0) {
+        std::uint64_t hash = sim.stateHash();
+        if (recording) {
+            recording->addCheckpoint(sim.getTick(), hash);
+        }
+        
+        std::uint64_t expected;
+        if (playback && playbackDivergedAt == 0 && playback->expectedHash(sim.getTick(), expected) && expected != hash) {
+            playbackDivergedAt = sim.getTick();
+            std::cout << "Replay diverged by tick " << sim.getTick() << " (state hash " << std::hex << hash
+                      << ", recorded " << expected << std::dec << ")" << std::endl;
+        }
+    }
+    
+    if (recording && currentState == GameState::GAME_OVER) {
+        finishRecording();
+    }
+    
+    if (playback) {
+        // Ticks stop on the victory screen, so when the player moved on doesn't matter
+        if (currentState == GameState::VICTORY && sim.getTick() < playback->getTickCount()) {
+            nextLevel();
+        }
+        if (sim.getTick() >= playback->getTickCount() || currentState != GameState::PLAYING) {
+            finishPlayback();
+        }
+    }
+}
+
+void Game::finishRecording() {
+    if (!recording) return;
+    if (recording->getTickCount() > 0) {
+        recording->save(recordPath);
+    }
+    recording.reset();
+}
+
+void Game::finishPlayback() {
+    if (!playback) return;
+    
+    // Frame-time profile of the simulation alone, comparable between builds
+    std::vector<float> sorted = tickTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (float time : sorted) {
+        total += time;
+    }
+    
+    std::cout << "Replay finished at tick " << sim.getTick() << " of " << playback->getTickCount()
+              << ", floor " << sim.getLevel() << ", score " << sim.getScore() << std::endl;
+    if (!sorted.empty()) {
+        std::cout << "  " << total / sorted.size() << " ms/tick avg, " << sorted[sorted.size() / 2] << " median, "
+                  << sorted[sorted.size() * 99 / 100] << " p99, " << sorted.back() << " worst" << std::endl;
+    }
+    if (playbackDivergedAt != 0) {
+        std::cout << "  DIVERGED by tick " << playbackDivergedAt << std::endl;
+    } else {
+        std::cout << "  All " << sim.getTick() / Replay::CHECKPOINT_INTERVAL << " checkpoints matched" << std::endl;
+    }
+    
+    playback.reset();
+    setInputSource(nullptr);
+    sim.setTuningReload(true);
+    if (playbackFast) {
+        isRunning = false;
+    } else if (currentState == GameState::PLAYING) {
+        currentState = GameState::WELCOME;
+    }
+}
+
+void Game::runReplayFast() {
+    // Ticks back to back with the recorded steps; nothing is drawn
+    while (playback) {
+        sf::Clock tickClock;
+        update(playback->getStep(sim.getTick() + 1));
+        tickTimes.push_back(tickClock.getElapsedTime().asSeconds() * 1000.0f);
+        updateReplay();
+    }
+}
+
+void Game::startAutoplay() {
+    autoplay = true;
+    setInputSource(std::make_unique<BotInput>(sim));
+    std::cout << "Autoplay: the bot is playing" << std::endl;
+    
+    // Straight into the run, as with a replay
+    currentState = GameState::PLAYING;
+    resetGame();
+    autoplayRuns = 1;
+}
+
+void Game::continueAutoplay() {
+    if (currentState == GameState::VICTORY) {
+        nextLevel();
+    } else if (currentState == GameState::GAME_OVER) {
+        std::cout << "Autoplay: run " << autoplayRuns << " died on floor " << sim.getLevel() << " after "
+                  << sim.getTick() << " ticks, score " << sim.getScore() << std::endl;
+        currentState = GameState::PLAYING;
+        resetGame();
+        autoplayRuns++;
+    }
+}
+
 void Game::renderWelcomeScreen() {
     // Refined gradient background with subtle depth
     sf::RectangleShape background(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
@@ -1384,22 +1383,22 @@ void Game::renderGameOverScreen() {
     window.draw(statsBg);
     
     // Final stats
-    std::string levelText = "REACHED LEVEL " + std::to_string(currentLevel);
+    std::string levelText = "REACHED LEVEL " + std::to_string(sim.getLevel());
     float levelTextWidth = levelText.length() * 7;
     float levelX = WINDOW_WIDTH/2 - levelTextWidth/2;
     drawSimpleText(window, levelText, levelX, 340);
     
-    std::string scoreText = "FINAL SCORE: " + std::to_string(score);
+    std::string scoreText = "FINAL SCORE: " + std::to_string(sim.getScore());
     float scoreTextWidth = scoreText.length() * 7;
     float scoreX = WINDOW_WIDTH/2 - scoreTextWidth/2;
     drawSimpleText(window, scoreText, scoreX, 360);
     
-    std::string treasureText = "TREASURES: " + std::to_string(treasuresCollected);
+    std::string treasureText = "TREASURES: " + std::to_string(sim.getTreasuresCollected());
     float treasureTextWidth = treasureText.length() * 7;
     float treasureX = WINDOW_WIDTH/2 - treasureTextWidth/2;
     drawSimpleText(window, treasureText, treasureX, 380);
     
-    std::string enemyText = "ENEMIES: " + std::to_string(enemiesKilled);
+    std::string enemyText = "ENEMIES: " + std::to_string(sim.getEnemiesKilled());
     float enemyTextWidth = enemyText.length() * 7;
     float enemyX = WINDOW_WIDTH/2 - enemyTextWidth/2;
     drawSimpleText(window, enemyText, enemyX, 400);
@@ -1418,24 +1417,8 @@ void Game::renderGameOverScreen() {
 }
 
 void Game::renderPauseScreen() {
-    // Render game world first (dimmed)
-    if (camera) {
-        camera->setView(window);
-    }
-    
-    if (dungeon) {
-        dungeon->render(window, camera ? camera->getView() : window.getDefaultView());
-    }
-    
-    if (player) {
-        player->render(window);
-    }
-    
-    for (auto& enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            enemy->render(window);
-        }
-    }
+    // Render game world first (dimmed), as of the last tick played
+    worldRenderer.render(window, snapshots.read());
     
     // Reset to default view for UI
     window.setView(window.getDefaultView());
@@ -1526,31 +1509,31 @@ void Game::renderVictoryScreen() {
     window.draw(statsBg);
     
     // Level info
-    std::string levelText = "LEVEL " + std::to_string(currentLevel - 1) + " COMPLETED";
+    std::string levelText = "LEVEL " + std::to_string(sim.getLevel() - 1) + " COMPLETED";
     float levelTextWidth = levelText.length() * 7;
     float levelX = WINDOW_WIDTH/2 - levelTextWidth/2;
     drawSimpleText(window, levelText, levelX, 320);
     
     // Score info
-    std::string scoreText = "SCORE: " + std::to_string(score);
+    std::string scoreText = "SCORE: " + std::to_string(sim.getScore());
     float scoreTextWidth = scoreText.length() * 7;
     float scoreX = WINDOW_WIDTH/2 - scoreTextWidth/2;
     drawSimpleText(window, scoreText, scoreX, 340);
     
     // Treasures info
-    std::string treasureText = "TREASURES: " + std::to_string(treasuresCollected);
+    std::string treasureText = "TREASURES: " + std::to_string(sim.getTreasuresCollected());
     float treasureTextWidth = treasureText.length() * 7;
     float treasureX = WINDOW_WIDTH/2 - treasureTextWidth/2;
     drawSimpleText(window, treasureText, treasureX, 360);
     
     // Enemies info
-    std::string enemyText = "ENEMIES DEFEATED: " + std::to_string(enemiesKilled);
+    std::string enemyText = "ENEMIES DEFEATED: " + std::to_string(sim.getEnemiesKilled());
     float enemyTextWidth = enemyText.length() * 7;
     float enemyX = WINDOW_WIDTH/2 - enemyTextWidth/2;
     drawSimpleText(window, enemyText, enemyX, 380);
     
     // Next level info
-    std::string nextLevelText = "NEXT: LEVEL " + std::to_string(currentLevel);
+    std::string nextLevelText = "NEXT: LEVEL " + std::to_string(sim.getLevel());
     float nextLevelTextWidth = nextLevelText.length() * 7;
     float nextLevelX = WINDOW_WIDTH/2 - nextLevelTextWidth/2;
     drawSimpleText(window, nextLevelText, nextLevelX, 420);
@@ -1564,9 +1547,10 @@ void Game::renderVictoryScreen() {
                       sf::Color(180, 180, 40), sf::Color(220, 220, 80));
 }
 
-void Game::drawSimpleText(sf::RenderWindow& window, const std::string& text, float x, float y) {
-    // Create simple pixel-based font system with 5x7 bitmap patterns
-    std::map<char, std::vector<std::string>> letterPatterns = {
+void Game::drawSimpleText(sf::RenderWindow& window, std::string_view text, float x, float y) {
+    // Create simple pixel-based font system with 5x7 bitmap patterns; built
+    // once, on first use
+    static const std::map<char, std::vector<std::string>> letterPatterns = {
         {'A', {"  *  ", " * * ", "*   *", "*****", "*   *", "*   *", "     "}},
         {'B', {"**** ", "*   *", "**** ", "**** ", "*   *", "**** ", "     "}},
         {'C', {" ****", "*    ", "*    ", "*    ", "*    ", " ****", "     "}},
@@ -1608,22 +1592,28 @@ void Game::drawSimpleText(sf::RenderWindow& window, const std::string& text, flo
         {'*', {"     ", " * * ", "  *  ", "*****", "  *  ", " * * ", "     "}}
     };
     
+    // Every lit pixel of the string goes into one batch and one draw call
+    sf::VertexArray& pixels = scratch.quadBatch();
     for (size_t i = 0; i < text.length(); ++i) {
         char c = std::toupper(text[i]);
         float charX = x + i * 7; // 6 pixels per char + 1 spacing
         
-        if (letterPatterns.find(c) != letterPatterns.end()) {
-            const auto& pattern = letterPatterns[c];
+        auto found = letterPatterns.find(c);
+        if (found != letterPatterns.end()) {
+            const auto& pattern = found->second;
             for (int row = 0; row < 7; ++row) {
                 for (int col = 0; col < 5; ++col) {
                     if (row < (int)pattern.size() && col < (int)pattern[row].length() && pattern[row][col] == '*') {
-                        sf::RectangleShape pixel(sf::Vector2f(1, 1));
-                        pixel.setFillColor(sf::Color::White);
-                        pixel.setPosition(charX + col, y + row);
-                        window.draw(pixel);
+                        float left = charX + col;
+                        float top = y + row;
+                        pixels.append(sf::Vertex(sf::Vector2f(left, top), sf::Color::White));
+                        pixels.append(sf::Vertex(sf::Vector2f(left + 1, top), sf::Color::White));
+                        pixels.append(sf::Vertex(sf::Vector2f(left + 1, top + 1), sf::Color::White));
+                        pixels.append(sf::Vertex(sf::Vector2f(left, top + 1), sf::Color::White));
                     }
                 }
             }
         }
     }
+    window.draw(pixels);
 }
\ No newline at end of file
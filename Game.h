@@ -1,15 +1,23 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <atomic>
 #include <memory>
+#include <random>
 #include <string>
-#include "Player.h"
-#include "Dungeon.h"
-#include "Camera.h"
-#include "Enemy.h"
+#include <string_view>
+#include <cstdint>
+#include <thread>
 #include "GameState.h"
 #include "UserManager.h"
 #include "TransitionManager.h"
-#include "PowerUp.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "FrameScratch.h"
+#include "InputSource.h"
+#include "BotInput.h"
+#include "TripleBuffer.h"
+#include "WorldRenderer.h"
+#include "WorldSnapshot.h"
 
 class Game {
 private:
@@ -17,22 +25,46 @@ private:
     sf::Clock clock;
     sf::Font font;
     
-    std::unique_ptr<Player> player;
-    std::unique_ptr<Dungeon> dungeon;
-    std::unique_ptr<Camera> camera;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::vector<std::unique_ptr<PowerUp>> powerUps;
+    Simulation sim; // The run itself; everything here is window, menus and pacing around it
+    std::unique_ptr<InputSource> input; // Sampled once per tick; null means the keyboard
+    KeyboardInput keyboard;    // Read on the main thread each frame...
+    LatchedInput keyboardLatch; // ...and handed to the ticks through here
+    FrameScratch scratch; // Transient HUD shapes and text quads
     std::unique_ptr<UserManager> userManager;
     std::unique_ptr<TransitionManager> transitionManager;
     
     GameState currentState;
-    int score;
-    int currentLevel;
-    int treasuresCollected;
-    int enemiesKilled;
-    int initialEnemyCount;
+    
+    // Fixed-step simulation: frame time fills the accumulator, and whole
+    // ticks drain it. Rendering blends the last two ticks.
+    float tickStep;
+    float accumulator;
     bool isRunning;
     
+    // Replays: every run is recorded when a path is set; a loaded replay
+    // drives the input and time steps instead of the keyboard and clock
+    std::string recordPath;
+    std::unique_ptr<Replay> recording;
+    std::unique_ptr<Replay> playback;
+    bool playbackFast;
+    std::uint32_t playbackDivergedAt; // First checkpoint that failed, 0 if none
+    std::vector<float> tickTimes;     // Milliseconds per tick during playback
+    
+    // Autoplay: BotInput plays, cleared floors are descended and a death
+    // starts a new run, with no keys pressed
+    bool autoplay;
+    int autoplayRuns;
+    
+    // Play runs on simThread, which publishes a snapshot after its ticks;
+    // the main thread handles events and draws the newest snapshot. While
+    // the thread runs it owns the world: the main thread stops it before
+    // touching anything else (pause, save, load, closing).
+    TripleBuffer<WorldSnapshot> snapshots;
+    WorldRenderer worldRenderer;
+    std::uint64_t snapshotSerial;
+    std::thread simThread;
+    std::atomic<bool> simRunning; // Cleared to stop it, and by the thread when play ends
+    
     // UI input handling
     std::string inputText;
     std::string username;
@@ -60,15 +92,10 @@ public:
     void render();
     void initializeGame();
     void resetGame();
-    void generateLevel();
-    void updateEnemies(float deltaTime);
-    void updatePowerUps(float deltaTime);
-    void generatePowerUps();
-    void checkVictoryConditions();
-    int getTotalTreasures();
-    int getInitialEnemyCount();
     void nextLevel();
-    void renderUI();
+    void saveGame();
+    void loadGame();
+    void renderUI(const HudSnapshot& hud);
     
     // New UI methods
     void renderWelcomeScreen();
@@ -88,13 +115,34 @@ public:
     void drawEnhancedButton(sf::RenderWindow& window, const std::string& text, float x, float y, 
                            float width, float height, sf::Color baseColor, sf::Color highlightColor);
     void transitionToState(GameState newState);
+    void setInputSource(std::unique_ptr<InputSource> source);
+    void setTickRate(int ticksPerSecond);
+    
+    // Simulation thread
+    int advanceSimulation(float frameTime, float& step); // Runs the ticks due; step is the last one's length
+    void startSimulation();
+    void stopSimulation(); // Returns once the thread has finished its tick
+    void simulationLoop();
+    bool simulating() const { return simThread.joinable(); } // Main thread only
+    void publishSnapshot(bool live, float step);
     
-    // Collision detection
-    bool checkWallCollision(sf::Vector2f position, sf::Vector2f size);
+    // Replays
+    void recordReplays(const std::string& path); // Each new run overwrites the file
+    bool playReplay(const std::string& path, bool fast);
+    void updateReplay();   // After each tick: checkpoints, level changes, end of playback
+    void finishRecording();
+    void finishPlayback();
+    void runReplayFast();  // No rendering or frame pacing
+    void startAutoplay();
+    void continueAutoplay(); // Between runs and floors, on the main thread
+    const Simulation& getSimulation() const { return sim; }
     
     // Text rendering
-    void drawSimpleText(sf::RenderWindow& window, const std::string& text, float x, float y);
+    void drawSimpleText(sf::RenderWindow& window, std::string_view text, float x, float y);
     
+    static const int DEFAULT_TICK_RATE = 60;
+    static const float MAX_FRAME_TIME;      // Longer frames (a breakpoint, a window drag) count as this
+    static const int MAX_TICKS_PER_FRAME;   // Catch-up limit; time beyond it is dropped
     static const int WINDOW_WIDTH = 1200;
     static const int WINDOW_HEIGHT = 800;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "InputSource.h"
+#include <SFML/Graphics.hpp>
+
+const std::int8_t InputCommand::AXIS_MAX;
+
+InputCommand KeyboardInput::sample(std::uint32_t) {
+    InputCommand command;
+    
+    // With opposite keys held, right and down win
+    int x = 0, y = 0;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) x = -1;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) x = 1;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) y = -1;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) y = 1;
+    command.moveX = static_cast<std::int8_t>(x * InputCommand::AXIS_MAX);
+    command.moveY = static_cast<std::int8_t>(y * InputCommand::AXIS_MAX);
+    
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) command.buttons |= BUTTON_ATTACK;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::F)) command.buttons |= BUTTON_THROW;
+    return command;
+}
+
+void LatchedInput::latch(const InputCommand& command) {
+    std::uint32_t packed = static_cast<std::uint8_t>(command.moveX)
+                         | static_cast<std::uint32_t>(static_cast<std::uint8_t>(command.moveY)) << 8
+                         | static_cast<std::uint32_t>(command.buttons) << 16;
+    latest.store(packed, std::memory_order_relaxed);
+    pressedSince.fetch_or(command.buttons, std::memory_order_relaxed);
+}
+
+InputCommand LatchedInput::sample(std::uint32_t) {
+    std::uint32_t packed = latest.load(std::memory_order_relaxed);
+    InputCommand command;
+    command.moveX = static_cast<std::int8_t>(packed & 0xFF);
+    command.moveY = static_cast<std::int8_t>((packed >> 8) & 0xFF);
+    command.buttons = static_cast<std::uint8_t>(packed >> 16) | pressedSince.exchange(0, std::memory_order_relaxed);
+    return command;
+}
+
+RecordedInput::RecordedInput(std::vector<InputCommand> recorded, std::uint32_t startTick)
+    : commands(std::move(recorded))
+    , firstTick(startTick) {
+}
+
+InputCommand RecordedInput::sample(std::uint32_t tick) {
+    if (tick < firstTick || finished(tick)) return InputCommand();
+    return commands[tick - firstTick];
+}
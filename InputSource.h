@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Everything the player can do in one tick, sampled once and handed to the
+// simulation. Axes run from -127 to 127, so analog sources fit as well as
+// the keyboard's full deflection.
+struct InputCommand {
+    std::int8_t moveX = 0;
+    std::int8_t moveY = 0;
+    std::uint8_t buttons = 0; // InputButton bits
+    
+    bool pressed(std::uint8_t button) const { return (buttons & button) != 0; }
+    bool operator==(const InputCommand& other) const {
+        return moveX == other.moveX && moveY == other.moveY && buttons == other.buttons;
+    }
+    bool operator!=(const InputCommand& other) const { return !(*this == other); }
+    
+    static const std::int8_t AXIS_MAX = 127;
+};
+
+enum InputButton : std::uint8_t {
+    BUTTON_ATTACK = 1 << 0,
+    BUTTON_THROW = 1 << 1
+};
+
+// Where a tick's command comes from. The simulation asks once per tick and
+// never looks at the keyboard itself, so it runs the same with or without
+// a window.
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+    virtual InputCommand sample(std::uint32_t tick) = 0;
+};
+
+// WASD or arrow keys to move, Space to attack, F to throw
+class KeyboardInput : public InputSource {
+public:
+    InputCommand sample(std::uint32_t tick) override;
+};
+
+// Carries commands from the thread that reads the devices to the one that
+// runs the ticks. latch() is called every frame with the current state;
+// sample() returns the latest movement plus any button seen since the last
+// sample, so a tap shorter than a tick still lands.
+class LatchedInput : public InputSource {
+private:
+    std::atomic<std::uint32_t> latest; // Packed command
+    std::atomic<std::uint8_t> pressedSince;
+
+public:
+    LatchedInput() : latest(0), pressedSince(0) {}
+    
+    void latch(const InputCommand& command);
+    InputCommand sample(std::uint32_t tick) override;
+};
+
+// Plays back a recorded command stream. Ticks past the end get an empty
+// command.
+class RecordedInput : public InputSource {
+private:
+    std::vector<InputCommand> commands;
+    std::uint32_t firstTick;
+
+public:
+    RecordedInput(std::vector<InputCommand> recorded, std::uint32_t startTick = 1);
+    
+    InputCommand sample(std::uint32_t tick) override;
+    bool finished(std::uint32_t tick) const { return tick >= firstTick + commands.size(); }
+};
+
+// Commands from code: bots, benchmarks and tests
+class ScriptedInput : public InputSource {
+private:
+    std::function<InputCommand(std::uint32_t)> script;
+
+public:
+    explicit ScriptedInput(std::function<InputCommand(std::uint32_t)> fn) : script(std::move(fn)) {}
+    
+    InputCommand sample(std::uint32_t tick) override { return script(tick); }
+};
@@ -0,0 +1,27 @@
+#include "LevelArena.h"
+
+LevelArena::LevelArena(size_t initialBytes)
+    : blocks(initialBytes, std::pmr::new_delete_resource())
+    , bytesUsed(0)
+    , allocationCount(0) {
+}
+
+void* LevelArena::do_allocate(size_t bytes, size_t alignment) {
+    bytesUsed += bytes;
+    allocationCount++;
+    return blocks.allocate(bytes, alignment);
+}
+
+void LevelArena::do_deallocate(void*, size_t, size_t) {
+    // Freed in bulk by reset()
+}
+
+bool LevelArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void LevelArena::reset() {
+    blocks.release();
+    bytesUsed = 0;
+    allocationCount = 0;
+}
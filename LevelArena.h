@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+// Monotonic arena for data that lives exactly as long as one level. Containers
+// take it as their std::pmr memory resource; allocation is a pointer bump and
+// deallocation does nothing. reset() hands every block back at once, so it
+// must only be called once nothing allocated from the arena is still in use.
+class LevelArena : public std::pmr::memory_resource {
+private:
+    std::pmr::monotonic_buffer_resource blocks;
+    size_t bytesUsed;
+    size_t allocationCount;
+    
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    // The first block is sized to hold a typical level in one piece
+    explicit LevelArena(size_t initialBytes);
+    
+    void reset();
+    
+    size_t getBytesUsed() const { return bytesUsed; }
+    size_t getAllocationCount() const { return allocationCount; }
+};
@@ -1,18 +1,29 @@
 #include "Player.h"
+#include "Combat.h"
+#include "StatusEffects.h"
 #include <iostream>
 #include <cmath>
 
 const float Player::PLAYER_SIZE = 24.0f;
 const float Player::PLAYER_SPEED = 200.0f;
+const float Player::ATTACK_COOLDOWN = 0.5f;
+const float Player::THROW_COOLDOWN = 0.4f;
+const float Player::THROW_SPEED = 420.0f;
 
 Player::Player(float x, float y) 
     : position(x, y)
+    , previousPosition(x, y)
     , velocity(0, 0)
     , isAttacking(false)
-    , attackCooldown(0.0f)
-    , speed(PLAYER_SPEED)
+    , clock(0.0)
+    , attackEndsAt(0.0)
+    , attackId(0)
+    , throwReadyAt(0.0)
+    , throwPending(false)
+    , facing(1.0f, 0.0f)
     , animationTimer(0.0f)
-    , currentFrame(0) {
+    , currentFrame(0)
+    , effects(nullptr) {
     
     // Initialize sprite
     sprite.setSize(sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE));
@@ -22,21 +33,25 @@ Player::Player(float x, float y)
     
     // Center the origin
     sprite.setOrigin(PLAYER_SIZE / 2, PLAYER_SIZE / 2);
+    
+    attackCircle.setRadius(60);
+    attackCircle.setFillColor(sf::Color(255, 255, 0, 150));
+    attackCircle.setOutlineThickness(3);
+    attackCircle.setOutlineColor(sf::Color::Red);
+    innerCircle.setRadius(30);
+    innerCircle.setFillColor(sf::Color(255, 0, 0, 200));
 }
 
-void Player::update(float deltaTime) {
-    // Update power-ups
-    updatePowerUps(deltaTime);
+void Player::update(float deltaTime, const InputCommand& command) {
+    clock += deltaTime;
+    previousPosition = position;
     
     // Handle input
-    handleInput();
+    applyCommand(command);
     
-    // Update attack cooldown
-    if (attackCooldown > 0) {
-        attackCooldown -= deltaTime;
-        if (attackCooldown <= 0) {
-            isAttacking = false;
-        }
+    // The swing shows until its cooldown runs out
+    if (isAttacking && clock >= attackEndsAt) {
+        isAttacking = false;
     }
     
     // Apply movement with effective speed
@@ -66,55 +81,47 @@ void Player::update(float deltaTime) {
     velocity = sf::Vector2f(0, 0);
 }
 
-void Player::render(sf::RenderWindow& window) {
+void Player::render(sf::RenderWindow& window, float alpha) {
+    sf::Vector2f drawn = previousPosition + (position - previousPosition) * alpha;
+    
     // Draw attack indicator - much more visible
     if (isAttacking) {
         // Large pulsing circle
-        sf::CircleShape attackCircle(60);
-        attackCircle.setFillColor(sf::Color(255, 255, 0, 150));
-        attackCircle.setPosition(position.x - 60, position.y - 60);
-        attackCircle.setOutlineThickness(3);
-        attackCircle.setOutlineColor(sf::Color::Red);
+        attackCircle.setPosition(drawn.x - 60, drawn.y - 60);
         window.draw(attackCircle);
         
         // Smaller inner circle
-        sf::CircleShape innerCircle(30);
-        innerCircle.setFillColor(sf::Color(255, 0, 0, 200));
-        innerCircle.setPosition(position.x - 30, position.y - 30);
+        innerCircle.setPosition(drawn.x - 30, drawn.y - 30);
         window.draw(innerCircle);
     }
     
+    sprite.setPosition(drawn);
     window.draw(sprite);
 }
 
-void Player::handleInput() {
+void Player::applyCommand(const InputCommand& command) {
     float effectiveSpeed = getEffectiveSpeed();
     
-    // Movement input
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
-        velocity.x = -effectiveSpeed;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
-        velocity.x = effectiveSpeed;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-        velocity.y = -effectiveSpeed;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
-        velocity.y = effectiveSpeed;
+    // Movement input, with diagonals and overlong analog input cut to unit length
+    sf::Vector2f direction(command.moveX, command.moveY);
+    direction /= static_cast<float>(InputCommand::AXIS_MAX);
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length > 1.0f) {
+        direction /= length;
     }
+    velocity = direction * effectiveSpeed;
     
-    // Normalize diagonal movement
-    if (velocity.x != 0 && velocity.y != 0) {
-        float length = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
-        velocity.x = velocity.x / length * speed;
-        velocity.y = velocity.y / length * speed;
+    if (length > 0.0f) {
+        facing = direction / std::min(length, 1.0f);
     }
     
     // Attack input
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && attackCooldown <= 0) {
+    if (command.pressed(BUTTON_ATTACK) && clock >= attackEndsAt) {
         attack();
     }
+    if (command.pressed(BUTTON_THROW) && clock >= throwReadyAt) {
+        throwWeapon();
+    }
 }
 
 void Player::move(float dx, float dy) {
@@ -124,23 +131,35 @@ void Player::move(float dx, float dy) {
 }
 
 void Player::attack() {
-    if (attackCooldown <= 0) {
+    if (clock >= attackEndsAt) {
         isAttacking = true;
-        attackCooldown = 0.5f; // 0.5 second cooldown
+        attackEndsAt = clock + ATTACK_COOLDOWN;
+        attackId++;
         
         sprite.setFillColor(sf::Color::Yellow);
     }
 }
 
-void Player::takeDamage(int damage) {
-    int effectiveArmor = getEffectiveArmor();
-    int actualDamage = std::max(1, damage - effectiveArmor);
+void Player::throwWeapon() {
+    if (clock >= throwReadyAt) {
+        throwReadyAt = clock + THROW_COOLDOWN;
+        throwPending = true;
+    }
+}
+
+bool Player::consumeThrow() {
+    bool thrown = throwPending;
+    throwPending = false;
+    return thrown;
+}
+
+int Player::takeDamage(int damage) {
+    int actualDamage = CombatSystem::mitigate(damage, getEffectiveArmor());
     stats.health = std::max(0, stats.health - actualDamage);
     
     // Visual feedback
     sprite.setFillColor(sf::Color::Red);
-    
-    std::cout << "Player took " << actualDamage << " damage (reduced by " << effectiveArmor << " armor)! Health: " << stats.health << "/" << stats.maxHealth << std::endl;
+    return actualDamage;
 }
 
 void Player::gainExperience(int exp) {
@@ -154,14 +173,7 @@ void Player::gainExperience(int exp) {
 }
 
 void Player::levelUp() {
-    stats.level++;
-    stats.experience = 0; // Reset experience for next level
-    
-    // Increase stats
-    stats.maxHealth += 20;
-    stats.health = stats.maxHealth; // Full heal on level up
-    stats.attack += 5;
-    stats.defense += 2;
+    stats.gainLevel();
     
     std::cout << "Level up! Now level " << stats.level << std::endl;
     
@@ -170,72 +182,32 @@ void Player::levelUp() {
 }
 
 void Player::setPosition(float x, float y) {
-    position.x = x;
-    position.y = y;
-    sprite.setPosition(position);
+    setPosition(sf::Vector2f(x, y));
 }
 
 void Player::setPosition(sf::Vector2f pos) {
+    // Placed, not moved: nothing to interpolate from
     position = pos;
+    previousPosition = pos;
     sprite.setPosition(position);
 }
 
-void Player::applyPowerUp(int powerUpType, int value, float duration) {
-    switch (powerUpType) {
-        case 0: // HEALTH_POTION
-            heal(value);
-            break;
-        case 1: // DAMAGE_BOOST
-            activePowerUps.damageBoost = value;
-            activePowerUps.damageBoostTimer = duration;
-            break;
-        case 2: // SPEED_BOOST
-            activePowerUps.speedBoost = value;
-            activePowerUps.speedBoostTimer = duration;
-            break;
-        case 3: // ARMOR_BOOST
-            activePowerUps.armorBoost = value;
-            activePowerUps.armorBoostTimer = duration;
-            break;
-    }
-}
-
-void Player::updatePowerUps(float deltaTime) {
-    if (activePowerUps.damageBoostTimer > 0) {
-        activePowerUps.damageBoostTimer -= deltaTime;
-        if (activePowerUps.damageBoostTimer <= 0) {
-            activePowerUps.damageBoost = 0;
-        }
-    }
-    
-    if (activePowerUps.speedBoostTimer > 0) {
-        activePowerUps.speedBoostTimer -= deltaTime;
-        if (activePowerUps.speedBoostTimer <= 0) {
-            activePowerUps.speedBoost = 0;
-        }
-    }
-    
-    if (activePowerUps.armorBoostTimer > 0) {
-        activePowerUps.armorBoostTimer -= deltaTime;
-        if (activePowerUps.armorBoostTimer <= 0) {
-            activePowerUps.armorBoost = 0;
-        }
-    }
-}
-
 void Player::heal(int amount) {
     stats.health = std::min(stats.maxHealth, stats.health + amount);
     std::cout << "Player healed for " << amount << " HP! Health: " << stats.health << "/" << stats.maxHealth << std::endl;
 }
 
 int Player::getEffectiveAttack() const {
-    return stats.attack + activePowerUps.damageBoost;
+    if (!effects) return stats.attack;
+    return stats.attack + effects->total(PLAYER_ENTITY, StatusType::DAMAGE_BOOST);
 }
 
 int Player::getEffectiveSpeed() const {
-    return PLAYER_SPEED + (PLAYER_SPEED * activePowerUps.speedBoost / 100);
+    if (!effects) return PLAYER_SPEED;
+    return PLAYER_SPEED + (PLAYER_SPEED * effects->total(PLAYER_ENTITY, StatusType::SPEED_BOOST) / 100);
 }
 
 int Player::getEffectiveArmor() const {
-    return stats.defense + activePowerUps.armorBoost;
+    if (!effects) return stats.defense;
+    return stats.defense + effects->total(PLAYER_ENTITY, StatusType::ARMOR_BOOST);
 }
\ No newline at end of file
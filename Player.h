@@ -1,6 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
+#include "InputSource.h"
+
+class StatusEffects;
 
 struct Stats {
     int health;
@@ -11,49 +15,60 @@ struct Stats {
     int level;
     
     Stats() : health(100), maxHealth(100), attack(15), defense(5), experience(0), level(1) {}
+    
+    // One level's growth, with a full heal
+    void gainLevel() {
+        level++;
+        experience = 0;
+        maxHealth += 20;
+        health = maxHealth;
+        attack += 5;
+        defense += 2;
+    }
 };
 
 class Player {
 private:
     sf::Vector2f position;
+    sf::Vector2f previousPosition; // At the start of the last update, for render interpolation
     sf::Vector2f velocity;
     sf::RectangleShape sprite;
+    sf::CircleShape attackCircle, innerCircle; // Attack indicator, built once
     sf::Color color;
     
     Stats stats;
     bool isAttacking;
-    float attackCooldown;
-    float speed;
+    double clock;        // Seconds of play; cooldowns are deadlines on it
+    double attackEndsAt;
+    std::uint32_t attackId; // Bumped per swing; a swing hits each enemy once
+    double throwReadyAt;
+    bool throwPending; // Thrown this frame; Game launches the projectile
+    sf::Vector2f facing; // Unit direction of the last movement
     
     // Animation
     float animationTimer;
     int currentFrame;
     
-    // Power-up effects
-    struct ActivePowerUp {
-        int damageBoost = 0;
-        int speedBoost = 0;
-        int armorBoost = 0;
-        float damageBoostTimer = 0.0f;
-        float speedBoostTimer = 0.0f;
-        float armorBoostTimer = 0.0f;
-    } activePowerUps;
-    
+    // Boosts from power-ups, owned by the game; null means none
+    const StatusEffects* effects;
+
 public:
     Player(float x, float y);
     
-    void update(float deltaTime);
-    void render(sf::RenderWindow& window);
-    void handleInput();
+    // One simulation tick, driven by that tick's command
+    void update(float deltaTime, const InputCommand& command);
+    void render(sf::RenderWindow& window, float alpha = 1.0f); // alpha blends from the previous update's position
+    void applyCommand(const InputCommand& command);
     void move(float dx, float dy);
     void attack();
-    void takeDamage(int damage);
+    void throwWeapon();
+    bool consumeThrow(); // True once per throw
+    int takeDamage(int damage); // Returns the damage after armor
     void gainExperience(int exp);
     void levelUp();
     
-    // Power-up methods
-    void applyPowerUp(int powerUpType, int value, float duration);
-    void updatePowerUps(float deltaTime);
+    // Effective stats add the player's active status effects
+    void setStatusEffects(const StatusEffects* statusEffects) { effects = statusEffects; }
     void heal(int amount);
     int getEffectiveAttack() const;
     int getEffectiveSpeed() const;
@@ -65,6 +80,8 @@ public:
     Stats getStats() const { return stats; }
     bool isAlive() const { return stats.health > 0; }
     bool getIsAttacking() const { return isAttacking; }
+    std::uint32_t getAttackId() const { return attackId; }
+    sf::Vector2f getFacing() const { return facing; }
     
     // Setters
     void setPosition(float x, float y);
@@ -72,4 +89,7 @@ public:
     
     static const float PLAYER_SIZE;
     static const float PLAYER_SPEED;
+    static const float ATTACK_COOLDOWN;
+    static const float THROW_COOLDOWN;
+    static const float THROW_SPEED;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity object pool. Every slot is constructed up front and stays
+// alive; acquire() hands out a free slot and release() returns it, so objects
+// (and whatever buffers they own) are recycled instead of reallocated. Slot
+// numbers are stable while in use, which makes them usable as grid ids.
+template <typename T>
+class Pool {
+private:
+    std::vector<T> slots;
+    std::vector<std::uint32_t> live;        // Slots in use, in no particular order
+    std::vector<std::int32_t> livePosition; // Index into live, -1 while free
+    std::vector<std::uint32_t> freeSlots;   // Stack; lowest slot on top after clear()
+
+public:
+    explicit Pool(size_t capacity)
+        : slots(capacity)
+        , livePosition(capacity, -1) {
+        live.reserve(capacity);
+        freeSlots.reserve(capacity);
+        clear();
+    }
+
+    // Returns nullptr when every slot is in use
+    T* acquire(std::uint32_t& slot) {
+        if (freeSlots.empty()) return nullptr;
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        livePosition[slot] = static_cast<std::int32_t>(live.size());
+        live.push_back(slot);
+        return &slots[slot];
+    }
+
+    void release(std::uint32_t slot) {
+        std::int32_t position = livePosition[slot];
+        if (position < 0) return;
+        std::uint32_t moved = live.back();
+        live[position] = moved;
+        livePosition[moved] = position;
+        live.pop_back();
+        livePosition[slot] = -1;
+        freeSlots.push_back(slot);
+    }
+
+    // Frees every slot; objects keep their state until reacquired
+    void clear() {
+        for (std::uint32_t slot : live) {
+            livePosition[slot] = -1;
+        }
+        live.clear();
+        freeSlots.clear();
+        for (size_t slot = slots.size(); slot-- > 0;) {
+            freeSlots.push_back(static_cast<std::uint32_t>(slot));
+        }
+    }
+
+    T& operator[](std::uint32_t slot) { return slots[slot]; }
+    const T& operator[](std::uint32_t slot) const { return slots[slot]; }
+    const std::vector<std::uint32_t>& liveSlots() const { return live; }
+    size_t size() const { return live.size(); }
+    size_t capacity() const { return slots.size(); }
+};
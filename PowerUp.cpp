@@ -1,61 +1,42 @@
 #include "PowerUp.h"
+#include "Archetypes.h"
 #include <cmath>
 
-PowerUp::PowerUp(PowerUpType t, float x, float y) 
-    : type(t), position(x, y), collected(false) {
+PowerUp::PowerUp()
+    : type(PowerUpType::HEALTH_POTION), collected(true) {
     
     shape.setSize(sf::Vector2f(20, 20));
-    shape.setPosition(x - 10, y - 10);
-    
-    // Set properties based on type
-    switch (type) {
-        case PowerUpType::HEALTH_POTION:
-            shape.setFillColor(sf::Color::Red);
-            effectValue = 30; // Heal 30 HP
-            effectDuration = 0.0f; // Instant effect
-            break;
-            
-        case PowerUpType::DAMAGE_BOOST:
-            shape.setFillColor(sf::Color::Yellow);
-            effectValue = 15; // +15 damage
-            effectDuration = 10.0f; // 10 seconds
-            break;
-            
-        case PowerUpType::SPEED_BOOST:
-            shape.setFillColor(sf::Color::Green);
-            effectValue = 50; // +50% speed
-            effectDuration = 8.0f; // 8 seconds
-            break;
-            
-        case PowerUpType::ARMOR_BOOST:
-            shape.setFillColor(sf::Color::Blue);
-            effectValue = 5; // +5 armor (damage reduction)
-            effectDuration = 12.0f; // 12 seconds
-            break;
-    }
-    
     shape.setOutlineThickness(2);
     shape.setOutlineColor(sf::Color::White);
+    symbol.setFillColor(sf::Color::White);
+}
+
+PowerUp::PowerUp(PowerUpType t, float x, float y) 
+    : PowerUp() {
+    reset(t, x, y);
 }
 
-void PowerUp::render(sf::RenderWindow& window) {
+void PowerUp::reset(PowerUpType t, float x, float y) {
+    type = t;
+    position = sf::Vector2f(x, y);
+    collected = false;
+    shape.setPosition(x - 10, y - 10);
+}
+
+void PowerUp::render(sf::RenderWindow& window, sf::Color color) {
     if (!collected) {
         // Add pulsing effect
         static float pulseTimer = 0.0f;
         pulseTimer += 0.02f;
         float pulse = 0.8f + 0.2f * std::sin(pulseTimer * 4.0f);
         
-        sf::Color currentColor = shape.getFillColor();
+        sf::Color currentColor = color;
         currentColor.a = (sf::Uint8)(255 * pulse);
         shape.setFillColor(currentColor);
         
         window.draw(shape);
         
         // Draw power-up symbol in center
-        sf::RectangleShape symbol(sf::Vector2f(8, 8));
-        symbol.setPosition(position.x - 4, position.y - 4);
-        symbol.setFillColor(sf::Color::White);
-        
         switch (type) {
             case PowerUpType::HEALTH_POTION:
                 // Draw cross symbol
@@ -99,9 +80,18 @@ void PowerUp::render(sf::RenderWindow& window) {
 bool PowerUp::checkCollision(sf::Vector2f playerPos, float playerSize) {
     if (collected) return false;
     
-    float distance = std::sqrt(std::pow(position.x - playerPos.x, 2) + 
-                              std::pow(position.y - playerPos.y, 2));
-    return distance <= (playerSize + 10);
+    float dx = position.x - playerPos.x;
+    float dy = position.y - playerPos.y;
+    float reach = playerSize + 10;
+    return dx * dx + dy * dy <= reach * reach;
+}
+
+float PowerUp::getEffectDuration() const {
+    return Archetypes::powerUp(type).effectDuration;
+}
+
+int PowerUp::getEffectValue() const {
+    return Archetypes::powerUp(type).effectValue;
 }
 
 void PowerUp::collect() {
@@ -13,20 +13,24 @@ private:
     PowerUpType type;
     sf::Vector2f position;
     bool collected;
-    sf::RectangleShape shape;
-    float effectDuration;
-    int effectValue;
+    sf::RectangleShape shape; // Effect and color come from the type's archetype
+    sf::RectangleShape symbol;
 
 public:
+    PowerUp();
     PowerUp(PowerUpType t, float x, float y);
     
-    void render(sf::RenderWindow& window);
+    // Reuse this object for a new pickup, keeping its shapes' buffers
+    void reset(PowerUpType t, float x, float y);
+    
+    // The type's color is passed in, so drawing never reads the live archetypes
+    void render(sf::RenderWindow& window, sf::Color color);
     bool checkCollision(sf::Vector2f playerPos, float playerSize);
     void collect();
     
     bool isCollected() const { return collected; }
     PowerUpType getType() const { return type; }
-    float getEffectDuration() const { return effectDuration; }
-    int getEffectValue() const { return effectValue; }
+    float getEffectDuration() const;
+    int getEffectValue() const;
     sf::Vector2f getPosition() const { return position; }
 };
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "ProjectileStore.h"
+#include "Dungeon.h"
+#include <cmath>
+
+const float ProjectileStore::RADIUS = 4.0f;
+const float ProjectileStore::LIFETIME = 2.5f;
+
+namespace {
+
+template <typename T>
+void swapAndPop(std::vector<T>& values, size_t i) {
+    values[i] = values.back();
+    values.pop_back();
+}
+
+} // namespace
+
+ProjectileStore::ProjectileStore(size_t maxProjectiles)
+    : capacity(maxProjectiles)
+    , vertices(sf::Quads) {
+    posX.reserve(capacity); posY.reserve(capacity);
+    velX.reserve(capacity); velY.reserve(capacity);
+    life.reserve(capacity);
+    damage.reserve(capacity);
+    owner.reserve(capacity);
+}
+
+bool ProjectileStore::spawn(ProjectileOwner from, sf::Vector2f position, sf::Vector2f velocity, int hitDamage) {
+    if (size() >= capacity) return false;
+    
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    velX.push_back(velocity.x);
+    velY.push_back(velocity.y);
+    life.push_back(LIFETIME);
+    damage.push_back(hitDamage);
+    owner.push_back(from);
+    return true;
+}
+
+void ProjectileStore::remove(size_t i) {
+    swapAndPop(posX, i);
+    swapAndPop(posY, i);
+    swapAndPop(velX, i);
+    swapAndPop(velY, i);
+    swapAndPop(life, i);
+    swapAndPop(damage, i);
+    swapAndPop(owner, i);
+}
+
+void ProjectileStore::clear() {
+    posX.clear(); posY.clear();
+    velX.clear(); velY.clear();
+    life.clear();
+    damage.clear();
+    owner.clear();
+}
+
+void ProjectileStore::update(float deltaTime, const Dungeon* dungeon) {
+    // Back to front: a removal swaps in a projectile we've already moved
+    for (size_t i = size(); i-- > 0;) {
+        life[i] -= deltaTime;
+        if (life[i] <= 0.0f) {
+            remove(i);
+            continue;
+        }
+        
+        sf::Vector2f from(posX[i], posY[i]);
+        sf::Vector2f to(from.x + velX[i] * deltaTime, from.y + velY[i] * deltaTime);
+        if (dungeon && dungeon->sweep(from, to) < 1.0f) {
+            remove(i);
+            continue;
+        }
+        posX[i] = to.x;
+        posY[i] = to.y;
+    }
+}
+
+void ProjectileStore::render(sf::RenderWindow& window, float lookBack) {
+    if (empty()) return;
+    window.draw(buildVertices(lookBack));
+}
+
+const sf::VertexArray& ProjectileStore::buildVertices(float lookBack) {
+    vertices.clear();
+    
+    // Thin quads stretched along the direction of flight
+    const float halfLength = 6.0f;
+    const float halfWidth = 1.5f;
+    const sf::Color playerColor(255, 220, 120);
+    const sf::Color enemyColor(230, 230, 255);
+    for (size_t i = 0; i < size(); i++) {
+        float speed = std::sqrt(velX[i] * velX[i] + velY[i] * velY[i]);
+        float dirX = speed > 0 ? velX[i] / speed : 1.0f;
+        float dirY = speed > 0 ? velY[i] / speed : 0.0f;
+        float alongX = dirX * halfLength, alongY = dirY * halfLength;
+        float acrossX = -dirY * halfWidth, acrossY = dirX * halfWidth;
+        sf::Color color = owner[i] == ProjectileOwner::PLAYER ? playerColor : enemyColor;
+        
+        // Flight is a straight line, so stepping back along it is exact
+        float x = posX[i] - velX[i] * lookBack;
+        float y = posY[i] - velY[i] * lookBack;
+        vertices.append(sf::Vertex(sf::Vector2f(x - alongX - acrossX, y - alongY - acrossY), color));
+        vertices.append(sf::Vertex(sf::Vector2f(x + alongX - acrossX, y + alongY - acrossY), color));
+        vertices.append(sf::Vertex(sf::Vector2f(x + alongX + acrossX, y + alongY + acrossY), color));
+        vertices.append(sf::Vertex(sf::Vector2f(x - alongX + acrossX, y - alongY + acrossY), color));
+    }
+    return vertices;
+}
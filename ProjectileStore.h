@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+class Dungeon;
+
+enum class ProjectileOwner : std::uint8_t {
+    PLAYER, // Hits enemies
+    ENEMY   // Hits the player
+};
+
+// Arrows and thrown weapons, stored as parallel arrays with a fixed
+// capacity reserved up front. spawn() fails when the store is full rather
+// than growing, and removal swaps the last projectile into the freed slot,
+// so the store never allocates after construction.
+class ProjectileStore {
+private:
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life; // Seconds left before it drops
+    std::vector<int> damage;
+    std::vector<ProjectileOwner> owner;
+    size_t capacity;
+    
+    // One quad per projectile, drawn in a single call; keeps its capacity
+    sf::VertexArray vertices;
+
+public:
+    explicit ProjectileStore(size_t maxProjectiles);
+    
+    bool spawn(ProjectileOwner from, sf::Vector2f position, sf::Vector2f velocity, int hitDamage);
+    void remove(size_t i);
+    void clear();
+    
+    // Moves every projectile, sweeping its path against the walls. Ones that
+    // hit a wall or run out of time are removed. The dungeon is optional.
+    void update(float deltaTime, const Dungeon* dungeon);
+    // lookBack draws each projectile that many seconds back along its
+    // flight, for interpolating between simulation ticks
+    void render(sf::RenderWindow& window, float lookBack = 0.0f);
+    const sf::VertexArray& buildVertices(float lookBack = 0.0f); // The batch render() draws
+    
+    size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+    size_t getCapacity() const { return capacity; }
+    sf::Vector2f getPosition(size_t i) const { return sf::Vector2f(posX[i], posY[i]); }
+    ProjectileOwner getOwner(size_t i) const { return owner[i]; }
+    int getDamage(size_t i) const { return damage[i]; }
+    
+    static const float RADIUS;   // For hit tests
+    static const float LIFETIME; // Seconds a projectile flies if it hits nothing
+};
@@ -0,0 +1,154 @@
+#include "Replay.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+const std::uint32_t Replay::CHECKPOINT_INTERVAL;
+
+namespace {
+
+const char MAGIC[4] = { 'D', 'C', 'R', 'P' };
+const std::uint32_t VERSION = 2;
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+// Steps compare by bit pattern so a run never merges ticks that differ
+bool sameTick(float stepA, const InputCommand& a, float stepB, const InputCommand& b) {
+    return std::memcmp(&stepA, &stepB, sizeof(float)) == 0 && a == b;
+}
+
+} // namespace
+
+Replay::Replay(unsigned int runSeed, std::uint64_t tuning)
+    : seed(runSeed)
+    , tuningHash(tuning) {
+}
+
+void Replay::record(float deltaTime, const InputCommand& command) {
+    steps.push_back(deltaTime);
+    commands.push_back(command);
+}
+
+void Replay::addCheckpoint(std::uint32_t tick, std::uint64_t hash) {
+    checkpoints.push_back(ReplayCheckpoint{ tick, hash });
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Could not write replay " << path << std::endl;
+        return false;
+    }
+    
+    // Count the runs first so the header is complete up front
+    std::uint32_t runCount = 0;
+    for (size_t i = 0; i < commands.size(); runCount++) {
+        size_t end = i + 1;
+        while (end < commands.size() && end - i < 0xFFFF && sameTick(steps[end], commands[end], steps[i], commands[i])) {
+            end++;
+        }
+        i = end;
+    }
+    
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue(file, VERSION);
+    writeValue(file, static_cast<std::uint32_t>(seed));
+    writeValue(file, tuningHash);
+    writeValue(file, static_cast<std::uint32_t>(commands.size()));
+    writeValue(file, runCount);
+    writeValue(file, static_cast<std::uint32_t>(checkpoints.size()));
+    
+    for (size_t i = 0; i < commands.size();) {
+        size_t end = i + 1;
+        while (end < commands.size() && end - i < 0xFFFF && sameTick(steps[end], commands[end], steps[i], commands[i])) {
+            end++;
+        }
+        writeValue(file, static_cast<std::uint16_t>(end - i));
+        writeValue(file, steps[i]);
+        writeValue(file, commands[i].moveX);
+        writeValue(file, commands[i].moveY);
+        writeValue(file, commands[i].buttons);
+        i = end;
+    }
+    
+    for (const ReplayCheckpoint& checkpoint : checkpoints) {
+        writeValue(file, checkpoint.tick);
+        writeValue(file, checkpoint.hash);
+    }
+    
+    std::cout << "Saved replay " << path << ": " << commands.size() << " ticks in " << runCount
+              << " runs, " << checkpoints.size() << " checkpoints" << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No replay found at " << path << std::endl;
+        return false;
+    }
+    
+    char magic[4] = {};
+    std::uint32_t version = 0, fileSeed = 0, tickCount = 0, runCount = 0, checkpointCount = 0;
+    std::uint64_t fileTuning = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readValue(file, version) || version != VERSION ||
+        !readValue(file, fileSeed) || !readValue(file, fileTuning) || !readValue(file, tickCount) ||
+        !readValue(file, runCount) || !readValue(file, checkpointCount)) {
+        std::cout << path << " is not a replay this build can read" << std::endl;
+        return false;
+    }
+    
+    seed = fileSeed;
+    tuningHash = fileTuning;
+    steps.clear();
+    commands.clear();
+    checkpoints.clear();
+    steps.reserve(tickCount);
+    commands.reserve(tickCount);
+    
+    for (std::uint32_t run = 0; run < runCount; run++) {
+        std::uint16_t length = 0;
+        float step = 0.0f;
+        InputCommand command;
+        if (!readValue(file, length) || !readValue(file, step) || !readValue(file, command.moveX) ||
+            !readValue(file, command.moveY) || !readValue(file, command.buttons)) {
+            std::cout << "Replay " << path << " is truncated" << std::endl;
+            return false;
+        }
+        steps.insert(steps.end(), length, step);
+        commands.insert(commands.end(), length, command);
+    }
+    
+    for (std::uint32_t i = 0; i < checkpointCount; i++) {
+        ReplayCheckpoint checkpoint;
+        if (!readValue(file, checkpoint.tick) || !readValue(file, checkpoint.hash)) {
+            std::cout << "Replay " << path << " is truncated" << std::endl;
+            return false;
+        }
+        checkpoints.push_back(checkpoint);
+    }
+    
+    if (commands.size() != tickCount) {
+        std::cout << "Replay " << path << " is corrupt" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Replay::expectedHash(std::uint32_t tick, std::uint64_t& hash) const {
+    // Checkpoints are taken on every interval boundary, in order
+    if (tick == 0 || tick % CHECKPOINT_INTERVAL != 0) return false;
+    size_t index = tick / CHECKPOINT_INTERVAL - 1;
+    if (index >= checkpoints.size() || checkpoints[index].tick != tick) return false;
+    hash = checkpoints[index].hash;
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InputSource.h"
+
+// State hash the simulation had at the end of a tick
+struct ReplayCheckpoint {
+    std::uint32_t tick;
+    std::uint64_t hash;
+};
+
+// One recorded run: the seed it started from, then the time step and input
+// command of every tick. Given the same build and tuning, feeding these back
+// reproduces the run exactly; checkpoints taken every CHECKPOINT_INTERVAL
+// ticks catch the tick where a playback starts to diverge.
+//
+// File layout, little-endian: "DCRP", version, seed (u32 each), hash of the
+// archetype tables (u64), tick count, run count, checkpoint count (u32
+// each), then runs of identical ticks as
+// { u16 length, f32 step, i8 moveX, i8 moveY, u8 buttons }, then checkpoints
+// as { u32 tick, u64 hash }. Held keys and a steady frame rate collapse into
+// long runs, so a minute of play is usually a few kilobytes.
+class Replay {
+private:
+    unsigned int seed;
+    std::uint64_t tuningHash; // Archetypes::tableHash() when recording started
+    std::vector<float> steps;            // Per tick, starting at tick 1
+    std::vector<InputCommand> commands;
+    std::vector<ReplayCheckpoint> checkpoints;
+
+public:
+    explicit Replay(unsigned int runSeed = 0, std::uint64_t tuning = 0);
+    
+    void record(float deltaTime, const InputCommand& command);
+    void addCheckpoint(std::uint32_t tick, std::uint64_t hash);
+    
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+    
+    unsigned int getSeed() const { return seed; }
+    std::uint64_t getTuningHash() const { return tuningHash; }
+    size_t getTickCount() const { return commands.size(); }
+    float getStep(std::uint32_t tick) const { return steps[tick - 1]; }
+    const std::vector<InputCommand>& getCommands() const { return commands; }
+    size_t getCheckpointCount() const { return checkpoints.size(); }
+    
+    // False if no checkpoint was recorded at this tick
+    bool expectedHash(std::uint32_t tick, std::uint64_t& hash) const;
+    
+    static const std::uint32_t CHECKPOINT_INTERVAL = 60;
+};
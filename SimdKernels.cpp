@@ -0,0 +1,274 @@
+#include "SimdKernels.h"
+#include <cmath>
+
+// SSE2 is part of x86-64; AVX2 is compiled per function and chosen at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DUNGEON_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if DUNGEON_SIMD_SSE2 && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define DUNGEON_SIMD_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace simd {
+
+// ---------------------------------------------------------------------------
+// Scalar reference path
+
+namespace scalar {
+
+void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq) {
+    for (size_t i = 0; i < count; i++) {
+        float dx = px - x[i];
+        float dy = py - y[i];
+        outDistSq[i] = dx * dx + dy * dy;
+    }
+}
+
+void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask) {
+    const float radiusSq = radius * radius;
+    for (size_t i = 0; i < count; i++) {
+        outMask[i] = distSq[i] <= radiusSq ? 1 : 0;
+    }
+}
+
+void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                 float* outDirX, float* outDirY, float* outDistance) {
+    for (size_t i = 0; i < count; i++) {
+        float dx = tx - x[i];
+        float dy = ty - y[i];
+        float distance = std::sqrt(dx * dx + dy * dy);
+        outDistance[i] = distance;
+        outDirX[i] = distance > 0.0f ? dx / distance : 0.0f;
+        outDirY[i] = distance > 0.0f ? dy / distance : 0.0f;
+    }
+}
+
+} // namespace scalar
+
+// ---------------------------------------------------------------------------
+// SSE2, 4 lanes
+
+namespace sse2 {
+
+#if DUNGEON_SIMD_SSE2
+
+bool available() { return true; }
+
+void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq) {
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpy = _mm_set1_ps(py);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(vpx, _mm_loadu_ps(x + i));
+        __m128 dy = _mm_sub_ps(vpy, _mm_loadu_ps(y + i));
+        _mm_storeu_ps(outDistSq + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    }
+    scalar::distanceSquared(x + i, y + i, count - i, px, py, outDistSq + i);
+}
+
+void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask) {
+    const __m128 vradiusSq = _mm_set1_ps(radius * radius);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int bits = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(distSq + i), vradiusSq));
+        outMask[i] = bits & 1;
+        outMask[i + 1] = (bits >> 1) & 1;
+        outMask[i + 2] = (bits >> 2) & 1;
+        outMask[i + 3] = (bits >> 3) & 1;
+    }
+    scalar::rangeMask(distSq + i, count - i, radius, outMask + i);
+}
+
+void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                 float* outDirX, float* outDirY, float* outDistance) {
+    const __m128 vtx = _mm_set1_ps(tx);
+    const __m128 vty = _mm_set1_ps(ty);
+    const __m128 zero = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(vtx, _mm_loadu_ps(x + i));
+        __m128 dy = _mm_sub_ps(vty, _mm_loadu_ps(y + i));
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        
+        // 0/0 lanes become NaN and are masked back to zero
+        __m128 nonZero = _mm_cmpgt_ps(distance, zero);
+        _mm_storeu_ps(outDistance + i, distance);
+        _mm_storeu_ps(outDirX + i, _mm_and_ps(nonZero, _mm_div_ps(dx, distance)));
+        _mm_storeu_ps(outDirY + i, _mm_and_ps(nonZero, _mm_div_ps(dy, distance)));
+    }
+    scalar::directionTo(x + i, y + i, count - i, tx, ty, outDirX + i, outDirY + i, outDistance + i);
+}
+
+#else
+
+bool available() { return false; }
+
+void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq) {
+    scalar::distanceSquared(x, y, count, px, py, outDistSq);
+}
+
+void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask) {
+    scalar::rangeMask(distSq, count, radius, outMask);
+}
+
+void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                 float* outDirX, float* outDirY, float* outDistance) {
+    scalar::directionTo(x, y, count, tx, ty, outDirX, outDirY, outDistance);
+}
+
+#endif
+
+} // namespace sse2
+
+// ---------------------------------------------------------------------------
+// AVX2, 8 lanes
+
+namespace avx2 {
+
+#if DUNGEON_SIMD_AVX2
+
+bool available() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return avx2 && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+AVX2_TARGET void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq) {
+    const __m256 vpx = _mm256_set1_ps(px);
+    const __m256 vpy = _mm256_set1_ps(py);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(vpx, _mm256_loadu_ps(x + i));
+        __m256 dy = _mm256_sub_ps(vpy, _mm256_loadu_ps(y + i));
+        _mm256_storeu_ps(outDistSq + i, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    }
+    scalar::distanceSquared(x + i, y + i, count - i, px, py, outDistSq + i);
+}
+
+AVX2_TARGET void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask) {
+    const __m256 vradiusSq = _mm256_set1_ps(radius * radius);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int bits = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(distSq + i), vradiusSq, _CMP_LE_OQ));
+        for (int lane = 0; lane < 8; lane++) {
+            outMask[i + lane] = (bits >> lane) & 1;
+        }
+    }
+    scalar::rangeMask(distSq + i, count - i, radius, outMask + i);
+}
+
+AVX2_TARGET void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                             float* outDirX, float* outDirY, float* outDistance) {
+    const __m256 vtx = _mm256_set1_ps(tx);
+    const __m256 vty = _mm256_set1_ps(ty);
+    const __m256 zero = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(vtx, _mm256_loadu_ps(x + i));
+        __m256 dy = _mm256_sub_ps(vty, _mm256_loadu_ps(y + i));
+        __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        
+        __m256 nonZero = _mm256_cmp_ps(distance, zero, _CMP_GT_OQ);
+        _mm256_storeu_ps(outDistance + i, distance);
+        _mm256_storeu_ps(outDirX + i, _mm256_and_ps(nonZero, _mm256_div_ps(dx, distance)));
+        _mm256_storeu_ps(outDirY + i, _mm256_and_ps(nonZero, _mm256_div_ps(dy, distance)));
+    }
+    scalar::directionTo(x + i, y + i, count - i, tx, ty, outDirX + i, outDirY + i, outDistance + i);
+}
+
+#else
+
+bool available() { return false; }
+
+void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq) {
+    sse2::distanceSquared(x, y, count, px, py, outDistSq);
+}
+
+void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask) {
+    sse2::rangeMask(distSq, count, radius, outMask);
+}
+
+void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                 float* outDirX, float* outDirY, float* outDistance) {
+    sse2::directionTo(x, y, count, tx, ty, outDirX, outDirY, outDistance);
+}
+
+#endif
+
+} // namespace avx2
+
+// ---------------------------------------------------------------------------
+// Runtime dispatch
+
+namespace {
+
+struct Dispatch {
+    void (*distanceSquared)(const float*, const float*, size_t, float, float, float*);
+    void (*rangeMask)(const float*, size_t, float, std::uint8_t*);
+    void (*directionTo)(const float*, const float*, size_t, float, float, float*, float*, float*);
+    const char* name;
+    
+    Dispatch() {
+        if (avx2::available()) {
+            distanceSquared = avx2::distanceSquared;
+            rangeMask = avx2::rangeMask;
+            directionTo = avx2::directionTo;
+            name = "AVX2";
+        } else if (sse2::available()) {
+            distanceSquared = sse2::distanceSquared;
+            rangeMask = sse2::rangeMask;
+            directionTo = sse2::directionTo;
+            name = "SSE2";
+        } else {
+            distanceSquared = scalar::distanceSquared;
+            rangeMask = scalar::rangeMask;
+            directionTo = scalar::directionTo;
+            name = "scalar";
+        }
+    }
+};
+
+const Dispatch& dispatch() {
+    static const Dispatch selected;
+    return selected;
+}
+
+} // namespace
+
+void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq) {
+    dispatch().distanceSquared(x, y, count, px, py, outDistSq);
+}
+
+void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask) {
+    dispatch().rangeMask(distSq, count, radius, outMask);
+}
+
+void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                 float* outDirX, float* outDirY, float* outDistance) {
+    dispatch().directionTo(x, y, count, tx, ty, outDirX, outDirY, outDistance);
+}
+
+const char* activeInstructionSet() {
+    return dispatch().name;
+}
+
+} // namespace simd
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Batched distance and range kernels over structure-of-arrays positions.
+// The plain functions dispatch at runtime to AVX2, SSE2 or scalar code. Every
+// path uses exact sqrt and division, so results are bit-identical whichever
+// one runs.
+namespace simd {
+
+// outDistSq[i] = squared distance from (x[i], y[i]) to (px, py)
+void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq);
+
+// outMask[i] = 1 when distSq[i] <= radius^2
+void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask);
+
+// Distance to (tx, ty) and the unit direction toward it; zero direction when coincident
+void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                 float* outDirX, float* outDirY, float* outDistance);
+
+// Name of the instruction set picked at startup
+const char* activeInstructionSet();
+
+// Individual paths, exposed for benchmarks
+namespace scalar {
+    void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq);
+    void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask);
+    void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                     float* outDirX, float* outDirY, float* outDistance);
+}
+
+namespace sse2 {
+    bool available();
+    void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq);
+    void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask);
+    void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                     float* outDirX, float* outDirY, float* outDistance);
+}
+
+namespace avx2 {
+    bool available();
+    void distanceSquared(const float* x, const float* y, size_t count, float px, float py, float* outDistSq);
+    void rangeMask(const float* distSq, size_t count, float radius, std::uint8_t* outMask);
+    void directionTo(const float* x, const float* y, size_t count, float tx, float ty,
+                     float* outDirX, float* outDirY, float* outDistance);
+}
+
+} // namespace simd
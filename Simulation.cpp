@@ -0,0 +1,617 @@
+#include "Simulation.h"
+#include "AllocationCounter.h"
+#include "Archetypes.h"
+#include "WorldSnapshot.h"
+#include <iostream>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+const int Simulation::DUNGEON_WIDTH;
+const int Simulation::DUNGEON_HEIGHT;
+const size_t Simulation::FLOOR_MEMORY_BUDGET;
+const size_t Simulation::MAX_POWERUPS;
+const size_t Simulation::ENEMY_CAPACITY;
+const size_t Simulation::PROJECTILE_CAPACITY;
+const float Simulation::TUNING_CHECK_INTERVAL = 1.0f;
+
+Simulation::Simulation(float width, float height, size_t threadCount)
+    : dungeon(nullptr)
+    , projectiles(PROJECTILE_CAPACITY)
+    , statusEffects(timers)
+    , workers(threadCount)
+    , powerUps(MAX_POWERUPS)
+    , viewWidth(width)
+    , viewHeight(height)
+    , state(GameState::PLAYING)
+    , score(0)
+    , currentLevel(1)
+    , currentFloor(0)
+    , tileUnderPlayer(TileType::FLOOR)
+    , currentRoom(-1)
+    , simulationTick(0)
+    , tuningReload(true)
+    , runSeed(0)
+    , treasuresCollected(0)
+    , enemiesKilled(0)
+    , initialEnemyCount(0) {
+    
+    enemies.setThreadPool(&workers);
+    enemies.reserve(ENEMY_CAPACITY);
+}
+
+void Simulation::startRun(unsigned int seed) {
+    // Everything the run does follows from its seed and the ticks' input,
+    // so clocks and the camera start over too
+    resetProgress();
+    state = GameState::PLAYING;
+    runSeed = seed;
+    rng.seed(runSeed);
+    simulationTick = 0;
+    statusEffects.clear();
+    timers.reset();
+    scheduleTuningCheck();
+    camera = std::make_unique<Camera>(viewWidth, viewHeight);
+    
+    // Start a fresh stack of floors
+    generateLevel(runSeed);
+    player.reset();
+    
+    // Floors are generated lazily, starting with the current one
+    enterFloor(currentLevel - 1, true);
+}
+
+void Simulation::resetProgress() {
+    currentLevel = 1;
+    treasuresCollected = 0;
+    enemiesKilled = 0;
+    score = 0;
+}
+
+void Simulation::tick(float deltaTime, const InputCommand& command) {
+    simulationTick++;
+    if (dungeon) {
+        dungeon->setTick(simulationTick);
+    }
+    
+    // Fires whatever is due: status effect expiries, the tuning file check
+    timers.advance(deltaTime);
+    
+    // The command is the only input; nothing here reads a device
+    if (player && player->isAlive()) {
+        player->update(deltaTime, command);
+        if (player->consumeThrow()) {
+            projectiles.spawn(ProjectileOwner::PLAYER, player->getPosition(),
+                              player->getFacing() * Player::THROW_SPEED, player->getEffectiveAttack());
+        }
+        
+        // Proper collision detection with boundaries
+        sf::Vector2f newPos = player->getPosition();
+        sf::FloatRect playerBounds = player->getBounds();
+        
+        // Check collision with walls using player bounds
+        if (checkWallCollision(newPos, sf::Vector2f(playerBounds.width, playerBounds.height))) {
+            // Revert to previous position
+            player->setPosition(lastSafePosition);
+        } else {
+            lastSafePosition = newPos;
+        }
+        
+        // Check treasure collection
+        TileType currentTile = dungeon->getTileType(newPos.x, newPos.y);
+        if (currentTile == TileType::TREASURE) {
+            // Collect treasure
+            score += 500;
+            treasuresCollected++;
+            player->gainExperience(50);
+            
+            std::cout << "Treasure collected! Total: " << treasuresCollected << std::endl;
+            
+            // Remove treasure (convert to floor)
+            dungeon->setTileTypeAt(newPos.x, newPos.y, TileType::FLOOR);
+            
+            if (camera) {
+                camera->shake(3.0f, 0.3f);
+            }
+        }
+        
+        // Attacks break cracked walls within reach
+        if (player->getIsAttacking()) {
+            int broken = dungeon->destroyWallsAround(player->getPosition(), 60.0f);
+            if (broken > 0) {
+                std::cout << "Broke through " << broken << " cracked wall(s)!" << std::endl;
+                if (camera) {
+                    camera->shake(4.0f, 0.25f);
+                }
+            }
+        }
+        
+        // Patch regions, navigation and FOV for whatever changed this tick
+        dungeon->updateDerived(player->getPosition());
+        
+        // Stairs trigger when the player steps onto them, not while standing on them
+        if (currentTile != tileUnderPlayer) {
+            tileUnderPlayer = currentTile;
+            
+            if (currentTile == TileType::STAIRS_UP && currentFloor > 0) {
+                enterFloor(currentFloor - 1, false);
+                return;
+            } else if (currentTile == TileType::STAIRS_DOWN) {
+                if (floors->getFloor(currentFloor).cleared) {
+                    enterFloor(currentFloor + 1, true);
+                    return;
+                }
+                std::cout << "The stairs are sealed until this floor's objectives are complete." << std::endl;
+            }
+        }
+        
+        // Entering a room wakes any enemies sleeping in it
+        int room = dungeon->getRoomAt(player->getPosition().x, player->getPosition().y);
+        if (room != currentRoom) {
+            currentRoom = room;
+            if (room >= 0) {
+                enemies.wakeArea(dungeon->getRoomBounds(room));
+            }
+        }
+        
+        // Update camera to follow player
+        if (camera) {
+            camera->update(player->getPosition(), deltaTime);
+        }
+        
+        // Update enemies
+        updateEnemies(deltaTime);
+        
+        // Update power-ups
+        updatePowerUps();
+        
+        // Check victory conditions for level progression
+        checkVictoryConditions();
+        
+        // Check if player is dead
+        if (!player->isAlive()) {
+            state = GameState::GAME_OVER;
+        }
+    }
+}
+
+void Simulation::nextLevel() {
+    std::cout << "Advancing to level " << currentLevel << "!" << std::endl;
+    
+    // Take the stairs down; the floor below is generated on first visit
+    enterFloor(currentLevel - 1, true);
+    
+    // Resume playing
+    state = GameState::PLAYING;
+}
+
+void Simulation::scheduleTuningCheck() {
+    // Pick up edits to the tuning file; live enemies and power-ups read
+    // their stats from the archetypes, so changes apply in place. The check
+    // stays scheduled when reloads are off, so the timers match either way.
+    timers.schedule(TUNING_CHECK_INTERVAL, [this]() {
+        if (tuningReload) {
+            Archetypes::reloadIfChanged();
+        }
+        scheduleTuningCheck();
+    });
+}
+
+void Simulation::generateLevel(unsigned int seed) {
+    // Each run gets its own seed; every floor's layout derives from it
+    floors = std::make_unique<DungeonStack>(DUNGEON_WIDTH, DUNGEON_HEIGHT, seed, FLOOR_MEMORY_BUDGET);
+    dungeon = nullptr;
+    currentFloor = 0;
+}
+
+void Simulation::enterFloor(int index, bool fromAbove) {
+    // Remember progress on the floor we are leaving
+    storeFloorProgress();
+    AllocationSnapshot loadStart = AllocationCounter::snapshot();
+    
+    currentFloor = index;
+    currentLevel = index + 1;
+    dungeon = &floors->getDungeon(index);
+    Floor& floor = floors->getFloor(index);
+    
+    // Arrive at the spawn when descending, or on the down stairs when climbing back up
+    sf::Vector2f arrival = fromAbove ? dungeon->getPlayerSpawn() : dungeon->getStairsDown();
+    if (player) {
+        player->setPosition(arrival);
+    } else {
+        std::cout << "Player spawn: " << arrival.x << ", " << arrival.y << std::endl;
+        player = std::make_unique<Player>(arrival.x, arrival.y);
+        player->setStatusEffects(&statusEffects);
+    }
+    lastSafePosition = arrival;
+    tileUnderPlayer = dungeon->getTileType(arrival.x, arrival.y);
+    currentRoom = -1; // Re-fire room activation on the new floor
+    
+    enemies.clear();
+    combat.clear();
+    projectiles.clear();
+    enemies.setDungeon(dungeon);
+    spawner.reset(*dungeon);
+    powerUps.clear(); // Free old power-ups; their slots are reused
+    
+    // Proximity grids cover the new floor
+    float worldWidth = dungeon->getWidth() * Dungeon::TILE_SIZE;
+    float worldHeight = dungeon->getHeight() * Dungeon::TILE_SIZE;
+    enemies.setWorldBounds(worldWidth, worldHeight);
+    pickupGrid.reset(worldWidth, worldHeight);
+    
+    if (!floor.visited) {
+        floor.visited = true;
+        treasuresCollected = 0;
+        enemiesKilled = 0;
+        
+        int enemyCount = 6 + (currentLevel - 1) * 2; // Scale with level: 6, 8, 10, 12...
+        enemyCount = std::min(enemyCount, 14); // Cap at 14 enemies
+        spawnEnemies(enemyCount);
+        initialEnemyCount = spawner.getDormantCount(); // Track actual enemy count
+        
+        generatePowerUps();
+    } else {
+        // Revisited floors come back as they were left: progress, survivors
+        // where they stood with their wounds, and uncollected pickups
+        treasuresCollected = floor.treasuresCollected;
+        enemiesKilled = floor.enemiesKilled;
+        initialEnemyCount = floor.initialEnemyCount;
+        
+        spawner.restoreRecords(floor.enemies);
+        for (const PickupRecord& record : floor.powerUps) {
+            std::uint32_t slot;
+            PowerUp* powerUp = powerUps.acquire(slot);
+            if (!powerUp) break;
+            powerUp->reset(record.type, record.x, record.y);
+            pickupGrid.insert(slot, sf::Vector2f(record.x, record.y));
+        }
+    }
+    
+    std::cout << "Entered floor " << currentLevel << " (" << floors->getResidentCount() << " floors resident, "
+              << floors->getResidentMemory() / 1024 << " KB)" << std::endl;
+    
+    // Level data goes to the floor's arena; anything else shows up here
+    AllocationSnapshot loadCost = AllocationCounter::since(loadStart);
+    const LevelArena& arena = dungeon->getArena();
+    std::cout << "Heap allocations: " << loadStart.allocations << " before load, "
+              << loadStart.allocations + loadCost.allocations << " after (+" << loadCost.allocations << ", "
+              << loadCost.bytes / 1024 << " KB); level arena holds " << arena.getBytesUsed() / 1024 << " KB in "
+              << arena.getAllocationCount() << " allocations" << std::endl;
+}
+
+void Simulation::storeFloorProgress() {
+    if (!dungeon) return;
+    
+    Floor& floor = floors->getFloor(currentFloor);
+    floor.treasuresCollected = treasuresCollected;
+    floor.enemiesKilled = enemiesKilled;
+    floor.initialEnemyCount = initialEnemyCount;
+    
+    // Live enemies are copied, not packed away, so saving mid-floor is safe
+    spawner.collectRecords(enemies, floor.enemies);
+    floor.powerUps.clear();
+    for (std::uint32_t slot : powerUps.liveSlots()) {
+        const PowerUp& powerUp = powerUps[slot];
+        floor.powerUps.push_back({ powerUp.getPosition().x, powerUp.getPosition().y, powerUp.getType() });
+    }
+}
+
+void Simulation::checkVictoryConditions() {
+    // Clear and consistent victory conditions:
+    // 1. Collect at least 2 treasures (minimum progress requirement)
+    // 2. AND defeat at least 50% of enemies OR collect ALL treasures
+    
+    int totalTreasures = getTotalTreasures();
+    int totalEnemies = initialEnemyCount;
+    
+    bool minimumTreasures = (treasuresCollected >= 2);
+    bool allTreasuresCollected = (treasuresCollected >= totalTreasures);
+    bool majorityEnemiesKilled = (enemiesKilled >= totalEnemies / 2);
+    
+    // Victory condition: minimum treasures AND (majority enemies killed OR all treasures)
+    bool levelComplete = minimumTreasures && (majorityEnemiesKilled || allTreasuresCollected);
+    
+    if (levelComplete && !floors->getFloor(currentFloor).cleared) {
+        floors->getFloor(currentFloor).cleared = true;
+        
+        std::cout << "=== LEVEL " << currentLevel << " COMPLETED! ===" << std::endl;
+        std::cout << "Treasures collected: " << treasuresCollected << "/" << totalTreasures << std::endl;
+        std::cout << "Enemies defeated: " << enemiesKilled << "/" << totalEnemies << std::endl;
+        std::cout << "Victory condition met!" << std::endl;
+        
+        currentLevel++;
+        state = GameState::VICTORY;
+    }
+}
+
+int Simulation::getTotalTreasures() const {
+    // Count treasures in current dungeon
+    int totalTreasures = 0;
+    if (dungeon) {
+        // Collected so far plus what the treasure index still holds
+        totalTreasures = treasuresCollected + dungeon->getTreasureCount();
+    }
+    return totalTreasures;
+}
+
+bool Simulation::save(const std::string& path) {
+    if (!floors) return false;
+    
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Could not write " << path << std::endl;
+        return false;
+    }
+    
+    // Seeds plus tile journals; levels are regenerated and replayed on load
+    storeFloorProgress();
+    std::int32_t header[3] = { currentFloor, score, static_cast<std::int32_t>(simulationTick) };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    floors->save(file);
+    
+    std::cout << "Game saved on floor " << currentLevel << std::endl;
+    return true;
+}
+
+bool Simulation::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No save file found" << std::endl;
+        return false;
+    }
+    
+    std::int32_t header[3] = {};
+    auto loaded = std::make_unique<DungeonStack>(DUNGEON_WIDTH, DUNGEON_HEIGHT, 0, FLOOR_MEMORY_BUDGET);
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || !loaded->load(file) ||
+        header[0] < 0 || header[0] >= loaded->getFloorCount()) {
+        std::cout << "Save file is corrupt" << std::endl;
+        return false;
+    }
+    
+    // The player keeps their current stats; only the dungeon is restored
+    floors = std::move(loaded);
+    dungeon = nullptr;
+    score = header[1];
+    simulationTick = header[2];
+    enterFloor(header[0], true);
+    
+    std::cout << "Game loaded on floor " << currentLevel << std::endl;
+    return true;
+}
+
+void Simulation::spawnEnemies(int count) {
+    if (count <= 0) return;
+    
+    std::pmr::vector<sf::Vector2f> enemySpawns = dungeon->getEnemySpawns(count);
+    
+    std::cout << "Generated " << enemySpawns.size() << " enemies for level " << currentLevel << std::endl;
+    for (const auto& spawn : enemySpawns) {
+        // Randomly choose enemy type; they stay dormant until the player nears their room
+        EnemyType type = static_cast<EnemyType>(rng() % 3);
+        spawner.addRecord(type, spawn.x, spawn.y);
+    }
+}
+
+void Simulation::updateEnemies(float deltaTime) {
+    if (!player) return;
+    
+    sf::Vector2f playerPos = player->getPosition();
+    
+    // Bring nearby rooms' enemies to life and pack distant ones away
+    spawner.update(playerPos, enemies);
+    
+    // Parallel phase: AI and movement for every scheduled enemy, deterministic
+    // for any thread count. LOD is measured from the camera.
+    sf::Vector2f viewCenter = camera ? camera->getCenter() : playerPos;
+    enemies.update(deltaTime, playerPos, viewCenter);
+    
+    // Serial phase from here on. Attacks queue hits; the combat pass applies
+    // them in a fixed order, so the outcome never depends on scheduling.
+    projectiles.update(deltaTime, dungeon);
+    combat.projectileHits(projectiles, enemies, playerPos, Player::PLAYER_SIZE / 2);
+    combat.enemyAttacks(enemies, projectiles, playerPos, Archetypes::maxAttackRange());
+    if (player->getIsAttacking()) {
+        // A swing lasts the whole cooldown but lands on each enemy once
+        combat.playerAttack(enemies, playerPos, 60.0f, player->getEffectiveAttack(), player->getAttackId());
+    }
+    
+    CombatReport report = combat.resolve(enemies, *player);
+    if (report.empty()) return;
+    
+    // Side effects once per tick, however many hits landed
+    score += 100 * report.kills;
+    enemiesKilled += report.kills;
+    if (report.experience > 0) {
+        player->gainExperience(report.experience);
+    }
+    if (camera && report.enemyHits > 0) {
+        camera->shake(std::min(5.0f + report.enemyHits, 10.0f), 0.2f);
+    }
+    
+    Stats stats = player->getStats();
+    if (report.enemyHits > 0) {
+        std::cout << "Hit " << report.enemyHits << " enemies for " << report.damageDealt << " damage";
+        if (report.kills > 0) {
+            std::cout << ", " << report.kills << " killed (total " << enemiesKilled << ")";
+        }
+        std::cout << std::endl;
+    }
+    if (report.playerHits > 0) {
+        std::cout << "Player took " << report.damageTaken << " damage from " << report.playerHits
+                  << " attacks! Health: " << stats.health << "/" << stats.maxHealth << std::endl;
+    }
+}
+
+void Simulation::generatePowerUps() {
+    powerUps.clear();
+    pickupGrid.clear();
+    
+    if (!dungeon) return;
+    
+    // Generate 3-5 power-ups per level
+    int powerUpCount = 3 + (rng() % 3);
+    
+    for (int i = 0; i < powerUpCount; i++) {
+        // Get random empty position
+        sf::Vector2f pos;
+        int attempts = 0;
+        do {
+            pos.x = 50 + rng() % (dungeon->getWidth() * 20 - 100);
+            pos.y = 50 + rng() % (dungeon->getHeight() * 20 - 100);
+            attempts++;
+        } while (dungeon->isWall(pos.x, pos.y) && attempts < 50);
+        
+        std::uint32_t slot;
+        PowerUp* powerUp = attempts < 50 ? powerUps.acquire(slot) : nullptr;
+        if (powerUp) {
+            // Random power-up type
+            PowerUpType type = static_cast<PowerUpType>(rng() % 4);
+            powerUp->reset(type, pos.x, pos.y);
+            pickupGrid.insert(slot, pos);
+        }
+    }
+    
+    std::cout << "Generated " << powerUps.size() << " power-ups for level " << currentLevel << std::endl;
+}
+
+void Simulation::updatePowerUps() {
+    if (!player) return;
+    
+    // Only pickups in the player's cell neighbourhood are tested
+    pickupGrid.queryRadius(player->getPosition(), Player::PLAYER_SIZE + 10, nearby);
+    
+    for (std::uint32_t slot : nearby) {
+        // Player collected power-up
+        PowerUp& powerUp = powerUps[slot];
+        PowerUpType type = powerUp.getType();
+        int value = powerUp.getEffectValue();
+        float duration = powerUp.getEffectDuration();
+        
+        // Boosts stack with any already running and expire on the timer wheel
+        switch (type) {
+            case PowerUpType::HEALTH_POTION: player->heal(value); break;
+            case PowerUpType::DAMAGE_BOOST: statusEffects.apply(PLAYER_ENTITY, StatusType::DAMAGE_BOOST, value, duration); break;
+            case PowerUpType::SPEED_BOOST: statusEffects.apply(PLAYER_ENTITY, StatusType::SPEED_BOOST, value, duration); break;
+            case PowerUpType::ARMOR_BOOST: statusEffects.apply(PLAYER_ENTITY, StatusType::ARMOR_BOOST, value, duration); break;
+        }
+        
+        // Visual/audio feedback
+        std::string powerUpName;
+        switch (type) {
+            case PowerUpType::HEALTH_POTION: powerUpName = "Health Potion"; break;
+            case PowerUpType::DAMAGE_BOOST: powerUpName = "Damage Boost"; break;
+            case PowerUpType::SPEED_BOOST: powerUpName = "Speed Boost"; break;
+            case PowerUpType::ARMOR_BOOST: powerUpName = "Armor Boost"; break;
+        }
+        
+        std::cout << "Collected " << powerUpName << "!" << std::endl;
+        
+        // Slots are stable, so the rest of this query stays valid
+        powerUp.collect();
+        pickupGrid.remove(slot);
+        powerUps.release(slot);
+    }
+}
+
+bool Simulation::checkWallCollision(sf::Vector2f position, sf::Vector2f size) {
+    if (!dungeon) return false;
+    
+    // Check all four corners of the player
+    sf::Vector2f topLeft = position - size / 2.0f;
+    sf::Vector2f topRight = sf::Vector2f(position.x + size.x / 2.0f, position.y - size.y / 2.0f);
+    sf::Vector2f bottomLeft = sf::Vector2f(position.x - size.x / 2.0f, position.y + size.y / 2.0f);
+    sf::Vector2f bottomRight = position + size / 2.0f;
+    
+    return dungeon->isWall(topLeft.x, topLeft.y) ||
+           dungeon->isWall(topRight.x, topRight.y) ||
+           dungeon->isWall(bottomLeft.x, bottomLeft.y) ||
+           dungeon->isWall(bottomRight.x, bottomRight.y);
+}
+
+void Simulation::writeSnapshot(WorldSnapshot& snapshot) {
+    if (dungeon) {
+        const std::pmr::vector<TileType>& tiles = dungeon->getTiles();
+        snapshot.width = dungeon->getWidth();
+        snapshot.height = dungeon->getHeight();
+        snapshot.tiles.assign(tiles.begin(), tiles.end());
+    } else {
+        snapshot.width = 0;
+        snapshot.height = 0;
+        snapshot.tiles.clear();
+    }
+    
+    snapshot.hasCamera = camera != nullptr;
+    if (camera) {
+        snapshot.camera = *camera;
+    }
+    snapshot.hasPlayer = player != nullptr;
+    if (player) {
+        snapshot.player = *player;
+    }
+    
+    // Enemies that can show on screen; the margin covers a tick of camera
+    // motion and shake, and detection rings reaching in from outside
+    sf::FloatRect enemyArea(0.0f, 0.0f, snapshot.width * Dungeon::TILE_SIZE, snapshot.height * Dungeon::TILE_SIZE);
+    if (camera) {
+        float margin = Archetypes::maxDetectionRange() + EnemyStore::ENEMY_SIZE;
+        sf::Vector2f center = camera->getCenter();
+        enemyArea = sf::FloatRect(center.x - viewWidth / 2 - margin, center.y - viewHeight / 2 - margin,
+                                  viewWidth + 2 * margin, viewHeight + 2 * margin);
+    }
+    enemies.writeSnapshot(snapshot.enemies, enemyArea);
+    snapshot.projectiles = projectiles;
+    
+    // Copied over slots kept from earlier publishes, so their shapes keep their buffers
+    snapshot.powerUpCount = 0;
+    for (std::uint32_t slot : powerUps.liveSlots()) {
+        snapshot.powerUps[snapshot.powerUpCount++] = powerUps[slot];
+    }
+    for (size_t t = 0; t < POWERUP_TYPE_COUNT; t++) {
+        snapshot.powerUpColors[t] = Archetypes::color(static_cast<PowerUpType>(t));
+    }
+    
+    HudSnapshot& hud = snapshot.hud;
+    if (player) {
+        hud.stats = player->getStats();
+        hud.effectiveAttack = player->getEffectiveAttack();
+        hud.attacking = player->getIsAttacking();
+    }
+    hud.level = currentLevel;
+    hud.treasuresCollected = treasuresCollected;
+    hud.totalTreasures = getTotalTreasures();
+    hud.enemiesKilled = enemiesKilled;
+    hud.initialEnemyCount = initialEnemyCount;
+}
+
+std::uint64_t Simulation::stateHash() const {
+    // FNV-1a over the run and the player, on top of the enemies' own hash
+    std::uint64_t hash = enemies.stateHash();
+    auto mix = [&hash](std::uint32_t value) {
+        for (int byte = 0; byte < 4; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    
+    mix(simulationTick);
+    mix(static_cast<std::uint32_t>(currentFloor));
+    mix(static_cast<std::uint32_t>(score));
+    mix(static_cast<std::uint32_t>(enemiesKilled));
+    mix(static_cast<std::uint32_t>(treasuresCollected));
+    mix(static_cast<std::uint32_t>(projectiles.size()));
+    mix(static_cast<std::uint32_t>(powerUps.size()));
+    if (player) {
+        sf::Vector2f position = player->getPosition();
+        std::uint32_t bits;
+        std::memcpy(&bits, &position.x, sizeof(bits));
+        mix(bits);
+        std::memcpy(&bits, &position.y, sizeof(bits));
+        mix(bits);
+        Stats stats = player->getStats();
+        mix(static_cast<std::uint32_t>(stats.health));
+        mix(static_cast<std::uint32_t>(stats.experience));
+        mix(static_cast<std::uint32_t>(stats.level));
+    }
+    return hash;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <random>
+#include <string>
+#include <cstdint>
+#include "Player.h"
+#include "Dungeon.h"
+#include "DungeonStack.h"
+#include "Camera.h"
+#include "Combat.h"
+#include "EnemyStore.h"
+#include "EnemySpawner.h"
+#include "GameState.h"
+#include "InputSource.h"
+#include "PowerUp.h"
+#include "ProjectileStore.h"
+#include "Pool.h"
+#include "SpatialHash.h"
+#include "StatusEffects.h"
+#include "ThreadPool.h"
+#include "TimerWheel.h"
+
+struct WorldSnapshot;
+
+// One run of the game with no window attached: the floor stack, the player,
+// enemies, combat, pickups and progression, advanced one fixed tick at a
+// time from InputCommands. Game wraps it with the window, menus and
+// rendering; the headless runner and bots drive it directly.
+class Simulation {
+private:
+    std::unique_ptr<Player> player;
+    std::unique_ptr<DungeonStack> floors;
+    Dungeon* dungeon; // Active floor, owned by floors
+    std::unique_ptr<Camera> camera; // Followed by the view; AI level of detail is measured from it
+    EnemyStore enemies;
+    EnemySpawner spawner; // Dormant enemies, per room
+    CombatSystem combat; // Hit events, resolved once per tick
+    ProjectileStore projectiles; // Arrows and thrown weapons, fixed capacity
+    TimerWheel timers; // Expirations and delayed callbacks, advanced once per tick
+    StatusEffects statusEffects; // Timed boosts; expire through the wheel
+    ThreadPool workers; // Shared by the batched simulation passes
+    Pool<PowerUp> powerUps; // Slots are reused from floor to floor
+    SpatialHash pickupGrid; // Keyed by power-up slot
+    std::vector<std::uint32_t> nearby; // Scratch for proximity queries
+    float viewWidth, viewHeight;
+    
+    GameState state; // PLAYING, VICTORY once a floor is cleared, GAME_OVER once the player dies
+    int score;
+    int currentLevel;
+    int currentFloor;
+    TileType tileUnderPlayer;
+    int currentRoom; // Room the player is in, -1 in corridors
+    std::uint32_t simulationTick;
+    bool tuningReload; // Off while a replay plays back, so stats stay as recorded
+    unsigned int runSeed; // Floors, enemy types and power-ups all derive from it
+    std::mt19937 rng;     // Run-time randomness, seeded from runSeed so replays match
+    sf::Vector2f lastSafePosition; // Where the player stood before this tick's move
+    int treasuresCollected;
+    int enemiesKilled;
+    int initialEnemyCount;
+    
+    void generateLevel(unsigned int seed);
+    void enterFloor(int index, bool fromAbove);
+    void storeFloorProgress();
+    void spawnEnemies(int count);
+    void updateEnemies(float deltaTime);
+    void generatePowerUps();
+    void updatePowerUps();
+    void checkVictoryConditions();
+    bool checkWallCollision(sf::Vector2f position, sf::Vector2f size);
+    void scheduleTuningCheck();
+
+public:
+    // The view size sets the camera, and with it the AI level of detail.
+    // threadCount 0 uses every core; runs side by side want 1 each.
+    Simulation(float viewWidth, float viewHeight, size_t threadCount = 0);
+    
+    // A new run from floor 1. Everything it does follows from the seed and
+    // the commands passed to tick().
+    void startRun(unsigned int seed);
+    void tick(float deltaTime, const InputCommand& command);
+    void nextLevel(); // After VICTORY: down the stairs, back to PLAYING
+    void resetProgress(); // Level, score and counts back to the start, for the menus
+    void setTuningReload(bool enabled) { tuningReload = enabled; }
+    
+    // Seeds, tile journals and what each floor was left with; levels are
+    // regenerated and replayed on load. The player keeps their current stats.
+    bool save(const std::string& path);
+    bool load(const std::string& path);
+    
+    // Copies what the renderer needs; reuses the snapshot's buffers
+    void writeSnapshot(WorldSnapshot& snapshot);
+    std::uint64_t stateHash() const; // Player, run progress and enemies
+    
+    GameState getState() const { return state; }
+    std::uint32_t getTick() const { return simulationTick; }
+    unsigned int getSeed() const { return runSeed; }
+    int getScore() const { return score; }
+    int getLevel() const { return currentLevel; }
+    int getTreasuresCollected() const { return treasuresCollected; }
+    int getTotalTreasures() const;
+    int getEnemiesKilled() const { return enemiesKilled; }
+    int getInitialEnemyCount() const { return initialEnemyCount; }
+    const Player* getPlayer() const { return player.get(); }
+    const Dungeon* getDungeon() const { return dungeon; }
+    const EnemyStore& getEnemies() const { return enemies; }
+    const Pool<PowerUp>& getPowerUps() const { return powerUps; }
+    
+    static const int DUNGEON_WIDTH = 60;
+    static const int DUNGEON_HEIGHT = 45;
+    static const size_t FLOOR_MEMORY_BUDGET = 4 * 1024 * 1024; // Resident floors beyond this are evicted
+    static const size_t MAX_POWERUPS = 16;
+    static const size_t ENEMY_CAPACITY = 256; // Reserved up front; enough for any floor's active rooms
+    static const size_t PROJECTILE_CAPACITY = 1024;
+    static const float TUNING_CHECK_INTERVAL;
+};
@@ -0,0 +1,178 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float worldWidth, float worldHeight, float cellPixels)
+    : cellSize(cellPixels), gridWidth(1), gridHeight(1) {
+    reset(worldWidth, worldHeight);
+}
+
+void SpatialHash::reset(float worldWidth, float worldHeight) {
+    gridWidth = std::max(1, static_cast<int>(std::ceil(worldWidth / cellSize)));
+    gridHeight = std::max(1, static_cast<int>(std::ceil(worldHeight / cellSize)));
+    
+    // Cells that survive the resize keep their capacity
+    cells.resize(gridWidth * gridHeight);
+    clear();
+}
+
+void SpatialHash::clear() {
+    // Keep each cell's capacity so refilling the grid doesn't allocate
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+    entityCell.clear();
+    positions.clear();
+}
+
+int SpatialHash::cellIndex(sf::Vector2f pos) const {
+    int cx = std::max(0, std::min(gridWidth - 1, static_cast<int>(std::floor(pos.x / cellSize))));
+    int cy = std::max(0, std::min(gridHeight - 1, static_cast<int>(std::floor(pos.y / cellSize))));
+    return cy * gridWidth + cx;
+}
+
+void SpatialHash::insert(std::uint32_t id, sf::Vector2f pos) {
+    if (id >= entityCell.size()) {
+        entityCell.resize(id + 1, -1);
+        positions.resize(id + 1);
+    }
+    if (entityCell[id] >= 0) {
+        unlink(id);
+    }
+    
+    int cell = cellIndex(pos);
+    cells[cell].push_back(id);
+    entityCell[id] = cell;
+    positions[id] = pos;
+}
+
+void SpatialHash::move(std::uint32_t id, sf::Vector2f pos) {
+    positions[id] = pos;
+    
+    int cell = cellIndex(pos);
+    if (cell == entityCell[id]) return;
+    
+    unlink(id);
+    cells[cell].push_back(id);
+    entityCell[id] = cell;
+}
+
+void SpatialHash::remove(std::uint32_t id) {
+    if (id >= entityCell.size() || entityCell[id] < 0) return;
+    unlink(id);
+    entityCell[id] = -1;
+}
+
+void SpatialHash::rename(std::uint32_t from, std::uint32_t to) {
+    if (from == to || from >= entityCell.size() || entityCell[from] < 0) return;
+    
+    int cell = entityCell[from];
+    std::vector<std::uint32_t>& ids = cells[cell];
+    *std::find(ids.begin(), ids.end(), from) = to;
+    
+    if (to >= entityCell.size()) {
+        entityCell.resize(to + 1, -1);
+        positions.resize(to + 1);
+    }
+    entityCell[to] = cell;
+    positions[to] = positions[from];
+    entityCell[from] = -1;
+}
+
+void SpatialHash::unlink(std::uint32_t id) {
+    std::vector<std::uint32_t>& ids = cells[entityCell[id]];
+    auto it = std::find(ids.begin(), ids.end(), id);
+    *it = ids.back();
+    ids.pop_back();
+}
+
+void SpatialHash::queryRadius(sf::Vector2f center, float radius, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    
+    int minX = std::max(0, static_cast<int>(std::floor((center.x - radius) / cellSize)));
+    int maxX = std::min(gridWidth - 1, static_cast<int>(std::floor((center.x + radius) / cellSize)));
+    int minY = std::max(0, static_cast<int>(std::floor((center.y - radius) / cellSize)));
+    int maxY = std::min(gridHeight - 1, static_cast<int>(std::floor((center.y + radius) / cellSize)));
+    
+    // Entities clamped into border cells can lie outside the queried cells' range
+    if (minX > maxX || minY > maxY) {
+        minX = std::min(minX, gridWidth - 1); maxX = std::max(maxX, 0);
+        minY = std::min(minY, gridHeight - 1); maxY = std::max(maxY, 0);
+    }
+    
+    const float radiusSq = radius * radius;
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            for (std::uint32_t id : cells[cy * gridWidth + cx]) {
+                float dx = positions[id].x - center.x;
+                float dy = positions[id].y - center.y;
+                if (dx * dx + dy * dy <= radiusSq) {
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::queryRadius(sf::Vector2f center, float radius, size_t limit, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (limit == 0) return;
+    
+    int minX = std::max(0, static_cast<int>(std::floor((center.x - radius) / cellSize)));
+    int maxX = std::min(gridWidth - 1, static_cast<int>(std::floor((center.x + radius) / cellSize)));
+    int minY = std::max(0, static_cast<int>(std::floor((center.y - radius) / cellSize)));
+    int maxY = std::min(gridHeight - 1, static_cast<int>(std::floor((center.y + radius) / cellSize)));
+    
+    if (minX > maxX || minY > maxY) {
+        minX = std::min(minX, gridWidth - 1); maxX = std::max(maxX, 0);
+        minY = std::min(minY, gridHeight - 1); maxY = std::max(maxY, 0);
+    }
+    
+    const float radiusSq = radius * radius;
+    auto scan = [&](int cell) {
+        for (std::uint32_t id : cells[cell]) {
+            float dx = positions[id].x - center.x;
+            float dy = positions[id].y - center.y;
+            if (dx * dx + dy * dy <= radiusSq) {
+                out.push_back(id);
+                if (out.size() == limit) return true;
+            }
+        }
+        return false;
+    };
+    
+    int home = cellIndex(center);
+    if (scan(home)) return;
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            int cell = cy * gridWidth + cx;
+            if (cell != home && scan(cell)) return;
+        }
+    }
+}
+
+void SpatialHash::queryAABB(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    
+    int minX = std::max(0, static_cast<int>(std::floor(area.left / cellSize)));
+    int maxX = std::min(gridWidth - 1, static_cast<int>(std::floor((area.left + area.width) / cellSize)));
+    int minY = std::max(0, static_cast<int>(std::floor(area.top / cellSize)));
+    int maxY = std::min(gridHeight - 1, static_cast<int>(std::floor((area.top + area.height) / cellSize)));
+    
+    if (minX > maxX || minY > maxY) {
+        minX = std::min(minX, gridWidth - 1); maxX = std::max(maxX, 0);
+        minY = std::min(minY, gridHeight - 1); maxY = std::max(maxY, 0);
+    }
+    
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            for (std::uint32_t id : cells[cy * gridWidth + cx]) {
+                const sf::Vector2f& pos = positions[id];
+                if (pos.x >= area.left && pos.x <= area.left + area.width &&
+                    pos.y >= area.top && pos.y <= area.top + area.height) {
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over the level for proximity queries. Entities are small integer
+// ids (indices into their owner's arrays); each id remembers its cell so a move
+// only touches the grid when the entity crosses a cell boundary. Positions
+// outside the level are clamped into the border cells.
+class SpatialHash {
+private:
+    float cellSize;
+    int gridWidth, gridHeight;
+    std::vector<std::vector<std::uint32_t>> cells;
+    std::vector<int> entityCell; // -1 when the id is not in the grid
+    std::vector<sf::Vector2f> positions;
+    
+    int cellIndex(sf::Vector2f pos) const;
+    void unlink(std::uint32_t id);
+    
+public:
+    SpatialHash(float worldWidth = 0.0f, float worldHeight = 0.0f, float cellPixels = 64.0f);
+    
+    void reset(float worldWidth, float worldHeight);
+    void clear();
+    
+    void insert(std::uint32_t id, sf::Vector2f pos);
+    void move(std::uint32_t id, sf::Vector2f pos);
+    void remove(std::uint32_t id);
+    void rename(std::uint32_t from, std::uint32_t to); // For swap-and-pop compaction
+    
+    // Results are appended to out, which is cleared first; pass the same vector
+    // every frame to avoid allocating.
+    void queryRadius(sf::Vector2f center, float radius, std::vector<std::uint32_t>& out) const;
+    // Stops after limit hits, searching the center's own cell first, so a
+    // crowded spot costs about limit checks rather than one per body in range
+    void queryRadius(sf::Vector2f center, float radius, size_t limit, std::vector<std::uint32_t>& out) const;
+
+    void queryAABB(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+    
+    float getCellSize() const { return cellSize; }
+};
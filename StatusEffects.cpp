@@ -0,0 +1,94 @@
+#include "StatusEffects.h"
+#include <algorithm>
+
+StatusEffects::StatusEffects(TimerWheel& wheel)
+    : timers(wheel) {
+}
+
+void StatusEffects::apply(EntityId entity, StatusType type, int magnitude, float duration) {
+    if (duration <= 0.0f) return;
+    
+    std::uint32_t slot;
+    if (!freeEffects.empty()) {
+        slot = freeEffects.back();
+        freeEffects.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(effects.size());
+        effects.push_back(Effect{ 0, StatusType::DAMAGE_BOOST, 0, TimerWheel::INVALID });
+    }
+    
+    Effect& effect = effects[slot];
+    effect.entity = entity;
+    effect.type = type;
+    effect.magnitude = magnitude;
+    effect.expiry = timers.schedule(duration, [this, slot]() { expire(slot); });
+    
+    Totals& entityTotals = totals[entity];
+    entityTotals.value[static_cast<size_t>(type)] += magnitude;
+    entityTotals.active++;
+}
+
+void StatusEffects::expire(std::uint32_t slot) {
+    // The wheel already dropped the timer
+    effects[slot].expiry = TimerWheel::INVALID;
+    release(slot);
+}
+
+void StatusEffects::release(std::uint32_t slot) {
+    Effect& effect = effects[slot];
+    timers.cancel(effect.expiry);
+    effect.expiry = TimerWheel::INVALID;
+    
+    // Entries stay in the map once made, so re-applying doesn't allocate
+    Totals& entityTotals = totals[effect.entity];
+    entityTotals.value[static_cast<size_t>(effect.type)] -= effect.magnitude;
+    entityTotals.active--;
+    freeEffects.push_back(slot);
+}
+
+void StatusEffects::remove(EntityId entity, StatusType type) {
+    for (std::uint32_t slot = 0; slot < effects.size(); slot++) {
+        const Effect& effect = effects[slot];
+        if (effect.expiry != TimerWheel::INVALID && effect.entity == entity && effect.type == type) {
+            release(slot);
+        }
+    }
+}
+
+void StatusEffects::clearEntity(EntityId entity) {
+    for (std::uint32_t slot = 0; slot < effects.size(); slot++) {
+        const Effect& effect = effects[slot];
+        if (effect.expiry != TimerWheel::INVALID && effect.entity == entity) {
+            release(slot);
+        }
+    }
+    totals.erase(entity);
+}
+
+void StatusEffects::clear() {
+    for (std::uint32_t slot = 0; slot < effects.size(); slot++) {
+        if (effects[slot].expiry != TimerWheel::INVALID) {
+            release(slot);
+        }
+    }
+    totals.clear();
+}
+
+int StatusEffects::total(EntityId entity, StatusType type) const {
+    auto found = totals.find(entity);
+    if (found == totals.end()) return 0;
+    return found->second.value[static_cast<size_t>(type)];
+}
+
+float StatusEffects::remaining(EntityId entity, StatusType type) const {
+    auto found = totals.find(entity);
+    if (found == totals.end() || found->second.active == 0) return 0.0f;
+    
+    double longest = 0.0;
+    for (const Effect& effect : effects) {
+        if (effect.expiry != TimerWheel::INVALID && effect.entity == entity && effect.type == type) {
+            longest = std::max(longest, timers.remaining(effect.expiry));
+        }
+    }
+    return static_cast<float>(longest);
+}
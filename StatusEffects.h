@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "TimerWheel.h"
+
+// Anything effects can be attached to. The player is entity 0; other systems
+// pick their own ids above it.
+typedef std::uint32_t EntityId;
+constexpr EntityId PLAYER_ENTITY = 0;
+
+enum class StatusType : std::uint8_t {
+    DAMAGE_BOOST, // Flat attack
+    SPEED_BOOST,  // Percent of base speed
+    ARMOR_BOOST   // Flat damage reduction
+};
+
+constexpr size_t STATUS_TYPE_COUNT = 3;
+
+// Timed modifiers on entities. Any number of effects can stack on one entity,
+// and same-type effects add up. Each effect schedules its own expiry on the
+// timer wheel, so nothing is polled per frame: an effect costs work when it
+// is applied and when it runs out.
+class StatusEffects {
+private:
+    struct Effect {
+        EntityId entity;
+        StatusType type;
+        int magnitude;
+        TimerId expiry; // TimerWheel::INVALID while the slot is free
+    };
+    
+    struct Totals {
+        int value[STATUS_TYPE_COUNT] = {};
+        std::uint32_t active = 0;
+    };
+    
+    TimerWheel& timers;
+    std::vector<Effect> effects;
+    std::vector<std::uint32_t> freeEffects;
+    std::unordered_map<EntityId, Totals> totals;
+    
+    void expire(std::uint32_t slot);
+    void release(std::uint32_t slot);
+
+public:
+    explicit StatusEffects(TimerWheel& wheel);
+    
+    // Stacks on top of whatever the entity already has
+    void apply(EntityId entity, StatusType type, int magnitude, float duration);
+    
+    // Ends effects early, without waiting for their timers
+    void remove(EntityId entity, StatusType type);
+    void clearEntity(EntityId entity);
+    void clear();
+    
+    // Sum of the entity's active effects of this type, 0 if none
+    int total(EntityId entity, StatusType type) const;
+    
+    // Seconds until the last effect of this type runs out
+    float remaining(EntityId entity, StatusType type) const;
+    size_t activeCount() const { return effects.size() - freeEffects.size(); }
+};
@@ -0,0 +1,80 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : job(nullptr), jobCount(0), jobGrain(1), nextItem(0), generation(0), activeWorkers(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    workers.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    grain = std::max<size_t>(grain, 1);
+    
+    // Small jobs aren't worth waking anyone for
+    if (workers.empty() || count <= grain) {
+        if (count > 0) fn(0, count);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        jobGrain = grain;
+        nextItem.store(0, std::memory_order_relaxed);
+        activeWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+    
+    runChunks();
+    
+    // Workers may still be inside fn; wait for all of them before it goes away
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return activeWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    size_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+        
+        runChunks();
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runChunks() {
+    while (true) {
+        size_t begin = nextItem.fetch_add(jobGrain, std::memory_order_relaxed);
+        if (begin >= jobCount) return;
+        (*job)(begin, std::min(begin + jobGrain, jobCount));
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. parallelFor() splits
+// [0, count) into chunks of `grain` items that workers claim in any order, and
+// the calling thread works through chunks too. The call returns once every
+// chunk is done. Callers must make each item independent of the others, so the
+// result doesn't depend on how chunks land on threads.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    
+    // Current job, published under the mutex before generation is bumped
+    const std::function<void(size_t, size_t)>* job;
+    size_t jobCount;
+    size_t jobGrain;
+    std::atomic<size_t> nextItem;
+    size_t generation;
+    size_t activeWorkers;
+    bool stopping;
+    
+    void workerLoop();
+    void runChunks();
+    
+public:
+    // threadCount includes the calling thread; 0 uses every hardware thread
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+    
+    size_t getThreadCount() const { return workers.size() + 1; }
+};
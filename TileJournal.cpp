@@ -0,0 +1,45 @@
+#include "TileJournal.h"
+#include <algorithm>
+#include <istream>
+#include <ostream>
+
+const std::uint32_t TileJournal::MAX_RESERVE = 65536;
+
+void TileJournal::append(std::uint32_t index, std::uint8_t oldType, std::uint8_t newType, std::uint32_t tick) {
+    entries.push_back({index, tick, oldType, newType});
+}
+
+void TileJournal::write(std::ostream& out) const {
+    std::uint32_t count = entries.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    
+    // 10 bytes per entry, no padding
+    for (const auto& entry : entries) {
+        out.write(reinterpret_cast<const char*>(&entry.index), sizeof(entry.index));
+        out.write(reinterpret_cast<const char*>(&entry.tick), sizeof(entry.tick));
+        out.write(reinterpret_cast<const char*>(&entry.oldType), sizeof(entry.oldType));
+        out.write(reinterpret_cast<const char*>(&entry.newType), sizeof(entry.newType));
+    }
+}
+
+bool TileJournal::read(std::istream& in) {
+    std::uint32_t count = 0;
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        return false;
+    }
+    
+    // The count comes from the file; reserve no more than a sane journal
+    // needs and let a bad count run out of stream instead of memory
+    entries.clear();
+    entries.reserve(std::min<std::uint32_t>(count, MAX_RESERVE));
+    for (std::uint32_t i = 0; i < count; i++) {
+        TileMutation entry;
+        in.read(reinterpret_cast<char*>(&entry.index), sizeof(entry.index));
+        in.read(reinterpret_cast<char*>(&entry.tick), sizeof(entry.tick));
+        in.read(reinterpret_cast<char*>(&entry.oldType), sizeof(entry.oldType));
+        in.read(reinterpret_cast<char*>(&entry.newType), sizeof(entry.newType));
+        if (!in) return false;
+        entries.push_back(entry);
+    }
+    return true;
+}
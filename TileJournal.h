@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// One runtime tile change: which tile, what it was, what it became, and when
+struct TileMutation {
+    std::uint32_t index;
+    std::uint32_t tick;
+    std::uint8_t oldType;
+    std::uint8_t newType;
+};
+
+// Append-only record of tile changes made after generation. A level is fully
+// described by its seed plus this journal, which is what saves store and
+// evicted floors are rebuilt from. Caches don't read it; Dungeon updates them
+// as each change is applied.
+class TileJournal {
+private:
+    std::vector<TileMutation> entries;
+    
+public:
+    void append(std::uint32_t index, std::uint8_t oldType, std::uint8_t newType, std::uint32_t tick);
+    void clear() { entries.clear(); }
+    
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const TileMutation& operator[](size_t i) const { return entries[i]; }
+    const std::vector<TileMutation>& getEntries() const { return entries; }
+    size_t getMemoryUsage() const { return entries.capacity() * sizeof(TileMutation); }
+    
+    // Compact binary form used by save files. read() checks the stream,
+    // not the values; the level that replays the entries checks those.
+    void write(std::ostream& out) const;
+    bool read(std::istream& in);
+    
+    static const std::uint32_t MAX_RESERVE; // Entries reserved up front on read
+};
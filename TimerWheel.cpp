@@ -0,0 +1,189 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cmath>
+
+const int TimerWheel::LEVELS;
+const int TimerWheel::SLOT_BITS;
+const int TimerWheel::SLOTS;
+const std::uint32_t TimerWheel::FIRING;
+const std::uint32_t TimerWheel::FREE;
+const TimerId TimerWheel::INVALID;
+
+namespace {
+
+// Generation in the high half, slot plus one in the low half, so 0 is never valid
+TimerId makeId(std::uint32_t index, std::uint32_t generation) {
+    return (static_cast<TimerId>(generation) << 32) | (index + 1);
+}
+
+} // namespace
+
+TimerWheel::TimerWheel(double secondsPerTick)
+    : tickSeconds(secondsPerTick)
+    , elapsed(0.0)
+    , currentTick(0)
+    , pendingCount(0) {
+    std::fill(heads, heads + FIRING + 1, -1);
+}
+
+void TimerWheel::link(std::uint32_t index) {
+    Timer& timer = timers[index];
+    timer.prev = -1;
+    timer.next = heads[timer.bucket];
+    if (timer.next >= 0) timers[timer.next].prev = static_cast<std::int32_t>(index);
+    heads[timer.bucket] = static_cast<std::int32_t>(index);
+}
+
+void TimerWheel::unlink(std::uint32_t index) {
+    Timer& timer = timers[index];
+    if (timer.prev >= 0) timers[timer.prev].next = timer.next;
+    else heads[timer.bucket] = timer.next;
+    if (timer.next >= 0) timers[timer.next].prev = timer.prev;
+}
+
+void TimerWheel::place(std::uint32_t index) {
+    // Coarsest level needed to tell the due tick apart from now
+    Timer& timer = timers[index];
+    std::uint64_t distance = timer.due - currentTick;
+    int level = 0;
+    while (level < LEVELS - 1 && distance >= (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    
+    // Past the top level's span: park in the farthest top slot and re-place on the way down
+    std::uint64_t due = timer.due;
+    std::uint64_t topSpan = std::uint64_t(1) << (SLOT_BITS * LEVELS);
+    if (distance >= topSpan) {
+        due = currentTick + topSpan - 1;
+    }
+    std::uint32_t slot = static_cast<std::uint32_t>((due >> (SLOT_BITS * level)) & (SLOTS - 1));
+    timer.bucket = level * SLOTS + slot;
+    link(index);
+}
+
+void TimerWheel::cascade(int level) {
+    // Re-place everything in this level's current slot; it all lands lower down
+    std::uint32_t bucket = level * SLOTS + static_cast<std::uint32_t>((currentTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    std::int32_t index = heads[bucket];
+    heads[bucket] = -1;
+    while (index >= 0) {
+        std::int32_t next = timers[index].next;
+        place(static_cast<std::uint32_t>(index));
+        index = next;
+    }
+}
+
+TimerId TimerWheel::schedule(double delay, std::function<void()> callback) {
+    std::uint32_t index;
+    if (!freeTimers.empty()) {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(timers.size());
+        timers.push_back(Timer{ nullptr, 0, -1, -1, FREE, 0 });
+    }
+    
+    Timer& timer = timers[index];
+    timer.callback = std::move(callback);
+    
+    // Always at least the next tick, so a callback never runs inside schedule()
+    double dueTime = elapsed + std::max(0.0, delay);
+    std::uint64_t due = static_cast<std::uint64_t>(std::ceil(dueTime / tickSeconds));
+    timer.due = std::max(due, currentTick + 1);
+    place(index);
+    pendingCount++;
+    return makeId(index, timer.generation);
+}
+
+bool TimerWheel::isPending(TimerId id) const {
+    std::uint32_t index = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    if (index == 0 || index > timers.size()) return false;
+    const Timer& timer = timers[index - 1];
+    return timer.bucket != FREE && timer.generation == static_cast<std::uint32_t>(id >> 32);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    if (!isPending(id)) return false;
+    std::uint32_t index = static_cast<std::uint32_t>(id & 0xFFFFFFFFu) - 1;
+    Timer& timer = timers[index];
+    unlink(index);
+    timer.bucket = FREE;
+    timer.generation++;
+    timer.callback = nullptr;
+    freeTimers.push_back(index);
+    pendingCount--;
+    return true;
+}
+
+double TimerWheel::remaining(TimerId id) const {
+    if (!isPending(id)) return 0.0;
+    const Timer& timer = timers[static_cast<std::uint32_t>(id & 0xFFFFFFFFu) - 1];
+    return std::max(0.0, timer.due * tickSeconds - elapsed);
+}
+
+void TimerWheel::advance(double deltaTime) {
+    double end = elapsed + deltaTime;
+    std::uint64_t target = static_cast<std::uint64_t>(std::floor(end / tickSeconds));
+    
+    while (currentTick < target) {
+        // Nothing scheduled: jump straight to the target
+        if (pendingCount == 0) {
+            currentTick = target;
+            break;
+        }
+        
+        currentTick++;
+        
+        // Callbacks see the time of their own tick, so timers they schedule
+        // line up with it even when one call covers many ticks
+        elapsed = std::max(elapsed, currentTick * tickSeconds);
+        
+        // When a level wraps to slot 0, the next level's current slot moves down
+        for (int level = 1; level < LEVELS; level++) {
+            if ((currentTick & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+            cascade(level);
+        }
+        
+        // Fire this tick's bucket. It is moved to FIRING first, so callbacks
+        // can cancel batch members or schedule new timers safely.
+        std::uint32_t bucket = static_cast<std::uint32_t>(currentTick & (SLOTS - 1));
+        heads[FIRING] = heads[bucket];
+        heads[bucket] = -1;
+        for (std::int32_t index = heads[FIRING]; index >= 0; index = timers[index].next) {
+            timers[index].bucket = FIRING;
+        }
+        
+        while (heads[FIRING] >= 0) {
+            std::uint32_t index = static_cast<std::uint32_t>(heads[FIRING]);
+            Timer& timer = timers[index];
+            unlink(index);
+            std::function<void()> callback = std::move(timer.callback);
+            timer.callback = nullptr;
+            timer.bucket = FREE;
+            timer.generation++;
+            freeTimers.push_back(index);
+            pendingCount--;
+            callback();
+        }
+    }
+    elapsed = end;
+}
+
+void TimerWheel::clear() {
+    for (std::uint32_t index = 0; index < timers.size(); index++) {
+        Timer& timer = timers[index];
+        if (timer.bucket == FREE) continue;
+        timer.bucket = FREE;
+        timer.generation++;
+        timer.callback = nullptr;
+        freeTimers.push_back(index);
+    }
+    std::fill(heads, heads + FIRING + 1, -1);
+    pendingCount = 0;
+}
+
+void TimerWheel::reset() {
+    clear();
+    elapsed = 0.0;
+    currentTick = 0;
+}
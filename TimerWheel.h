@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Handle to a scheduled timer. Handles carry a generation, so a stale one
+// (already fired or cancelled) is recognised instead of hitting a reused slot.
+typedef std::uint64_t TimerId;
+
+// Hierarchical timing wheel. Time is cut into ticks; each level is a ring of
+// SLOTS buckets, and every level up covers SLOTS times the span of the one
+// below. A timer sits in the bucket of the coarsest level that still tells
+// its tick apart and drops down a level whenever the wheel below wraps.
+// Scheduling and cancelling are O(1), and advancing costs one bucket per tick
+// plus the timers that fire or cascade; timers far in the future cost
+// nothing while time passes.
+class TimerWheel {
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const std::uint32_t FIRING = LEVELS * SLOTS; // Bucket for the batch being fired
+    static const std::uint32_t FREE = FIRING + 1;
+    
+    struct Timer {
+        std::function<void()> callback;
+        std::uint64_t due;       // Tick it fires on
+        std::int32_t prev, next; // Bucket list
+        std::uint32_t bucket;    // FREE when not scheduled
+        std::uint32_t generation;
+    };
+    
+    std::vector<Timer> timers;
+    std::vector<std::uint32_t> freeTimers;
+    std::int32_t heads[LEVELS * SLOTS + 1]; // Last one is FIRING
+    double tickSeconds;
+    double elapsed;            // Seconds advanced so far
+    std::uint64_t currentTick; // Every timer due at or before this has fired
+    size_t pendingCount;
+    
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void place(std::uint32_t index);
+    void cascade(int level);
+
+public:
+    explicit TimerWheel(double secondsPerTick = 1.0 / 60.0);
+    
+    // Fires after at least `delay` seconds, at the end of the tick it falls in.
+    // Callbacks may schedule and cancel timers, including themselves.
+    TimerId schedule(double delay, std::function<void()> callback);
+    bool cancel(TimerId id); // False if it already fired or was cancelled
+    bool isPending(TimerId id) const;
+    double remaining(TimerId id) const; // 0 unless pending
+    
+    // Moves time forward, firing due timers in order of their tick
+    void advance(double deltaTime);
+    
+    // Drops every timer without firing it; the clock keeps running
+    void clear();
+    
+    // Drops every timer and rewinds the clock to zero, for a fresh run
+    void reset();
+    
+    double now() const { return elapsed; }
+    size_t pending() const { return pendingCount; }
+    
+    static const TimerId INVALID = 0;
+};
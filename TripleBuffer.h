@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Single-producer, single-consumer handoff of whole values. The writer fills
+// its back buffer and publishes it; the reader picks up the newest published
+// buffer and keeps it until it asks again. Neither side ever waits for the
+// other, and nothing is allocated after construction: the three buffers are
+// swapped by index through one atomic.
+template <typename T>
+class TripleBuffer {
+private:
+    static const std::uint32_t INDEX = 3;
+    static const std::uint32_t FRESH = 4; // Middle holds a buffer the reader hasn't seen
+    
+    T buffers[3];
+    std::atomic<std::uint32_t> middle; // Index, plus FRESH
+    std::uint32_t back;  // Writer's
+    std::uint32_t front; // Reader's
+
+public:
+    // Each buffer is constructed from the same arguments
+    template <typename... Args>
+    explicit TripleBuffer(const Args&... args)
+        : buffers{ T(args...), T(args...), T(args...) }
+        , middle(1)
+        , back(0)
+        , front(2) {}
+    
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+    
+    // Writer side. The back buffer holds whatever was written to it three
+    // publishes ago, so reuse-friendly types keep their capacity.
+    T& writeBuffer() { return buffers[back]; }
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+    
+    // Reader side: the newest published value, or the last one read if
+    // nothing was published since
+    T& read() {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        }
+        return buffers[front];
+    }
+};
@@ -0,0 +1,143 @@
+#include "WorldRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+void appendQuad(sf::VertexArray& vertices, float left, float top, float width, float height, sf::Color color) {
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left + width, top), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left + width, top + height), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left, top + height), color));
+}
+
+} // namespace
+
+WorldRenderer::WorldRenderer()
+    : width(0)
+    , height(0)
+    , chunksX(0)
+    , chunksY(0)
+    , drawnSerial(0)
+    , bodyVertices(sf::Quads)
+    , barVertices(sf::Quads) {
+    detectionCircle.setFillColor(sf::Color(255, 0, 0, 20));
+}
+
+void WorldRenderer::render(sf::RenderWindow& window, WorldSnapshot& snapshot) {
+    float alpha = snapshot.interpolation();
+    sf::View view = snapshot.hasCamera ? snapshot.camera.getView(alpha) : window.getDefaultView();
+    window.setView(view);
+    
+    if (snapshot.serial != drawnSerial) {
+        syncTiles(snapshot);
+    }
+    renderTiles(window, view);
+    
+    if (snapshot.hasPlayer) {
+        snapshot.player.render(window, alpha);
+    }
+    renderEnemies(window, snapshot.enemies, alpha);
+    
+    // Projectiles move in straight lines, so they step back along their
+    // velocity instead of keeping a previous position
+    snapshot.projectiles.render(window, (1.0f - alpha) * snapshot.step);
+    
+    for (size_t i = 0; i < snapshot.powerUpCount; i++) {
+        PowerUp& powerUp = snapshot.powerUps[i];
+        powerUp.render(window, snapshot.powerUpColors[static_cast<size_t>(powerUp.getType())]);
+    }
+}
+
+void WorldRenderer::syncTiles(const WorldSnapshot& snapshot) {
+    drawnSerial = snapshot.serial;
+    
+    // A new floor size starts the mesh over
+    if (snapshot.width != width || snapshot.height != height) {
+        width = snapshot.width;
+        height = snapshot.height;
+        chunksX = (width + Dungeon::CHUNK_SIZE - 1) / Dungeon::CHUNK_SIZE;
+        chunksY = (height + Dungeon::CHUNK_SIZE - 1) / Dungeon::CHUNK_SIZE;
+        chunkVertices.assign(chunksX * chunksY, sf::VertexArray(sf::Quads));
+        drawnTiles.assign(snapshot.tiles.begin(), snapshot.tiles.end());
+        for (int y = 0; y < chunksY; y++) {
+            for (int x = 0; x < chunksX; x++) {
+                Dungeon::buildChunkVertices(drawnTiles.data(), width, height, x, y, chunkVertices[y * chunksX + x]);
+            }
+        }
+        return;
+    }
+    
+    // Otherwise only chunks with a changed tile, whether from a pickup or a
+    // different floor of the same size
+    for (int chunkY = 0; chunkY < chunksY; chunkY++) {
+        for (int chunkX = 0; chunkX < chunksX; chunkX++) {
+            int startX = chunkX * Dungeon::CHUNK_SIZE;
+            int endX = std::min(width, startX + Dungeon::CHUNK_SIZE);
+            int endY = std::min(height, (chunkY + 1) * Dungeon::CHUNK_SIZE);
+            bool changed = false;
+            for (int y = chunkY * Dungeon::CHUNK_SIZE; y < endY; y++) {
+                size_t row = static_cast<size_t>(y) * width;
+                if (!std::equal(snapshot.tiles.begin() + row + startX, snapshot.tiles.begin() + row + endX,
+                                drawnTiles.begin() + row + startX)) {
+                    std::copy(snapshot.tiles.begin() + row + startX, snapshot.tiles.begin() + row + endX,
+                              drawnTiles.begin() + row + startX);
+                    changed = true;
+                }
+            }
+            if (changed) {
+                Dungeon::buildChunkVertices(drawnTiles.data(), width, height, chunkX, chunkY,
+                                            chunkVertices[chunkY * chunksX + chunkX]);
+            }
+        }
+    }
+}
+
+void WorldRenderer::renderTiles(sf::RenderWindow& window, const sf::View& view) {
+    // Only the chunks the view overlaps
+    const float chunkPixels = Dungeon::CHUNK_SIZE * Dungeon::TILE_SIZE;
+    float left = view.getCenter().x - view.getSize().x / 2;
+    float top = view.getCenter().y - view.getSize().y / 2;
+    int startX = std::max(0, static_cast<int>(std::floor(left / chunkPixels)));
+    int endX = std::min(chunksX, static_cast<int>(std::floor((left + view.getSize().x) / chunkPixels)) + 1);
+    int startY = std::max(0, static_cast<int>(std::floor(top / chunkPixels)));
+    int endY = std::min(chunksY, static_cast<int>(std::floor((top + view.getSize().y) / chunkPixels)) + 1);
+    
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            window.draw(chunkVertices[y * chunksX + x]);
+        }
+    }
+}
+
+void WorldRenderer::renderEnemies(sf::RenderWindow& window, const EnemySnapshot& enemies, float alpha) {
+    bodyVertices.clear();
+    barVertices.clear();
+    
+    const size_t count = enemies.size();
+    const float half = EnemyStore::ENEMY_SIZE / 2;
+    for (size_t i = 0; i < count; i++) {
+        float x = enemies.prevX[i] + (enemies.x[i] - enemies.prevX[i]) * alpha;
+        float y = enemies.prevY[i] + (enemies.y[i] - enemies.prevY[i]) * alpha;
+        
+        // Draw detection range (debug)
+        float range = enemies.detectionRange[i];
+        if (range > 0.0f) {
+            detectionCircle.setRadius(range);
+            detectionCircle.setPosition(x - range, y - range);
+            window.draw(detectionCircle);
+        }
+        
+        appendQuad(bodyVertices, x - half, y - half, EnemyStore::ENEMY_SIZE, EnemyStore::ENEMY_SIZE, enemies.color[i]);
+        
+        // Draw health bar above enemy
+        if (enemies.healthFraction[i] < 1.0f) {
+            appendQuad(barVertices, x - 15, y - 20, 30, 4, sf::Color::Red);
+            appendQuad(barVertices, x - 15, y - 20, 30.0f * enemies.healthFraction[i], 4, sf::Color::Green);
+        }
+    }
+    
+    // One draw call for all bodies, one for all health bars
+    window.draw(bodyVertices);
+    window.draw(barVertices);
+}
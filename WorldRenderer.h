@@ -0,0 +1,32 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "WorldSnapshot.h"
+
+// Draws the world from a WorldSnapshot. Keeps its own copy of the tile grid
+// and one vertex array per chunk; a new snapshot only rebuilds the chunks
+// whose tiles changed, so a floor's mesh is built once, not every frame.
+class WorldRenderer {
+private:
+    std::vector<TileType> drawnTiles;
+    std::vector<sf::VertexArray> chunkVertices;
+    int width, height;
+    int chunksX, chunksY;
+    std::uint64_t drawnSerial; // Snapshot the tiles were last synced to
+    
+    // Reused enemy geometry
+    sf::VertexArray bodyVertices;
+    sf::VertexArray barVertices;
+    sf::CircleShape detectionCircle;
+    
+    void syncTiles(const WorldSnapshot& snapshot);
+    void renderTiles(sf::RenderWindow& window, const sf::View& view);
+    void renderEnemies(sf::RenderWindow& window, const EnemySnapshot& enemies, float alpha);
+
+public:
+    WorldRenderer();
+    
+    // Leaves the camera's view set; the caller switches back for the HUD
+    void render(sf::RenderWindow& window, WorldSnapshot& snapshot);
+};
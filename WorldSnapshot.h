@@ -0,0 +1,92 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "Archetypes.h"
+#include "Camera.h"
+#include "Dungeon.h"
+#include "Player.h"
+#include "PowerUp.h"
+#include "ProjectileStore.h"
+
+// Drawable state of the live enemies, written by EnemyStore::writeSnapshot.
+// Colors and ranges are resolved at write time, so drawing reads nothing
+// the simulation owns.
+struct EnemySnapshot {
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;    // One tick earlier, for interpolation
+    std::vector<sf::Color> color;       // Hit and attack flashes applied
+    std::vector<float> detectionRange;  // 0 unless chasing
+    std::vector<float> healthFraction;  // Bar is hidden at 1
+    
+    size_t size() const { return x.size(); }
+    void reserve(size_t capacity) {
+        x.reserve(capacity);
+        y.reserve(capacity);
+        prevX.reserve(capacity);
+        prevY.reserve(capacity);
+        color.reserve(capacity);
+        detectionRange.reserve(capacity);
+        healthFraction.reserve(capacity);
+    }
+};
+
+// HUD numbers as of the snapshot's tick
+struct HudSnapshot {
+    Stats stats;
+    int effectiveAttack = 0;
+    bool attacking = false;
+    int level = 1;
+    int treasuresCollected = 0;
+    int totalTreasures = 0;
+    int enemiesKilled = 0;
+    int initialEnemyCount = 0;
+};
+
+// Everything drawn for one tick, copied out of the simulation so the render
+// thread never touches live state. Snapshots are recycled through a
+// TripleBuffer and overwritten in place; the containers keep their capacity
+// from one publish to the next.
+struct WorldSnapshot {
+    std::uint64_t serial = 0; // Publish count; 0 for a buffer never written
+    
+    // Interpolation: the tick before blends into this one over step seconds,
+    // starting leftover seconds in at publishedAt
+    bool live = false; // False draws the tick as is (paused, or not yet running)
+    float step = 1.0f / 60.0f;
+    float leftover = 0.0f;
+    std::chrono::steady_clock::time_point publishedAt;
+    
+    int width = 0, height = 0;
+    std::vector<TileType> tiles; // Row-major, as in Dungeon
+    
+    bool hasCamera = false;
+    Camera camera;
+    bool hasPlayer = false;
+    Player player;
+    EnemySnapshot enemies;
+    ProjectileStore projectiles;
+    std::vector<PowerUp> powerUps; // First powerUpCount are live; the rest are spares
+    size_t powerUpCount = 0;
+    sf::Color powerUpColors[POWERUP_TYPE_COUNT];
+    HudSnapshot hud;
+    
+    // Sized for the game's capacities, so publishing never allocates
+    WorldSnapshot(float viewWidth, float viewHeight, size_t enemyCapacity, size_t projectileCapacity,
+                  size_t powerUpCapacity)
+        : camera(viewWidth, viewHeight)
+        , player(0.0f, 0.0f)
+        , projectiles(projectileCapacity)
+        , powerUps(powerUpCapacity) {
+        enemies.reserve(enemyCapacity);
+    }
+    
+    // 0 at the previous tick, 1 at this one
+    float interpolation() const {
+        if (!live) return 1.0f;
+        float since = std::chrono::duration<float>(std::chrono::steady_clock::now() - publishedAt).count();
+        return std::min(1.0f, (leftover + since) / step);
+    }
+};
@@ -1,9 +1,41 @@
 #include "Game.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
         Game game;
+        
+        // --record FILE saves each run; --replay FILE plays one back, --fast without drawing;
+        // --tick-rate N sets the simulation rate (60 by default); --bot lets the bot play
+        bool fast = false;
+        bool bot = false;
+        const char* replayPath = nullptr;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+                game.recordReplays(argv[++i]);
+            } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+                replayPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--fast") == 0) {
+                fast = true;
+            } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+                game.setTickRate(std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--bot") == 0) {
+                bot = true;
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--tick-rate N] [--record FILE] [--replay FILE [--fast] | --bot]"
+                          << std::endl;
+                return -1;
+            }
+        }
+        if (replayPath && !game.playReplay(replayPath, fast)) {
+            return -1;
+        }
+        if (bot && !replayPath) {
+            game.startAutoplay(); // A replay brings its own input
+        }
+        
         game.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -11,4 +43,4 @@ int main() {
     }
     
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,318 @@
+// Monte Carlo combat balance: many abstract fights between the player and
+// a pack of one enemy type, per player level and power-up, run in parallel.
+// Build with `make balance`, then
+//
+//     ./dungeon_balance [--fights N] [--levels N] [--pack N] [--limit SECONDS] [--player-miss P]
+//                       [--enemy-miss P] [--seed S] [--threads N] [--csv FILE]
+//
+// A fight is swings and enemy attacks on their cooldowns, starting at random
+// points in them, each missing with the given chance (out of reach, dodged).
+// Damage goes through CombatSystem::mitigate, levels through
+// Stats::gainLevel and stats come from Archetypes with tuning.txt applied,
+// so the numbers follow the game's own formulas. Movement, projectile
+// flight and experience gained mid-fight are left out.
+//
+// Prints survival and time-to-kill percentiles per scenario; --csv writes
+// the survival curve and time-to-kill distribution in 0.1 s steps.
+#include "Archetypes.h"
+#include "Combat.h"
+#include "Player.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock BalanceClock;
+
+// Power-up state going into the fight. Boosts are picked up at the start
+// and run out after their duration; the potion is drunk at half health.
+enum class Buff {
+    NONE,
+    DAMAGE,
+    ARMOR,
+    POTION
+};
+
+constexpr size_t BUFF_COUNT = 4;
+const char* const BUFF_NAMES[BUFF_COUNT] = { "none", "damage", "armor", "potion" };
+
+const int MAX_PACK = 16;
+const float BIN_SECONDS = 0.1f;
+const size_t FIGHTS_PER_ITEM = 1000; // Fights per parallel work item, each with its own seed
+
+struct Options {
+    long fights = 20000; // Per scenario
+    int levels = 10;
+    int pack = 1;
+    float limit = 60.0f;
+    float playerMiss = 0.2f;
+    float enemyMiss = 0.2f;
+    unsigned int seed = 1;
+    size_t threads = 0;
+    const char* csvPath = nullptr;
+};
+
+struct Scenario {
+    EnemyType enemy;
+    int level;
+    Buff buff;
+};
+
+// Counts for one scenario, or one work item's share of it. Death and kill
+// times are histograms so shares add up without keeping every sample.
+struct Outcome {
+    long fights = 0;
+    long wins = 0;
+    long deaths = 0;
+    long healthLeft = 0; // Summed over wins
+    std::vector<std::uint32_t> killTimes;
+    std::vector<std::uint32_t> deathTimes;
+    
+    explicit Outcome(size_t bins = 0) : killTimes(bins), deathTimes(bins) {}
+    
+    void add(const Outcome& other) {
+        fights += other.fights;
+        wins += other.wins;
+        deaths += other.deaths;
+        healthLeft += other.healthLeft;
+        for (size_t bin = 0; bin < killTimes.size(); bin++) {
+            killTimes[bin] += other.killTimes[bin];
+            deathTimes[bin] += other.deathTimes[bin];
+        }
+    }
+};
+
+size_t binOf(float time, size_t bins) {
+    return std::min(bins - 1, static_cast<size_t>(time / BIN_SECONDS));
+}
+
+void fight(const Scenario& scenario, const Options& options, std::mt19937& rng, Outcome& out) {
+    Stats stats;
+    for (int level = 1; level < scenario.level; level++) {
+        stats.gainLevel();
+    }
+    const EnemyArchetype& enemy = Archetypes::enemy(scenario.enemy);
+    const PowerUpArchetype& damageBoost = Archetypes::powerUp(PowerUpType::DAMAGE_BOOST);
+    const PowerUpArchetype& armorBoost = Archetypes::powerUp(PowerUpType::ARMOR_BOOST);
+    const PowerUpArchetype& potion = Archetypes::powerUp(PowerUpType::HEALTH_POTION);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const size_t bins = out.killTimes.size();
+    
+    int health[MAX_PACK];
+    float nextAttack[MAX_PACK];
+    for (int i = 0; i < options.pack; i++) {
+        health[i] = enemy.health;
+        nextAttack[i] = unit(rng) * enemy.attackCooldown;
+    }
+    int alive = options.pack;
+    float nextSwing = unit(rng) * Player::ATTACK_COOLDOWN;
+    bool potionLeft = scenario.buff == Buff::POTION;
+    out.fights++;
+    
+    while (true) {
+        int attacker = 0;
+        for (int i = 1; i < options.pack; i++) {
+            if (health[i] > 0 && (health[attacker] <= 0 || nextAttack[i] < nextAttack[attacker])) attacker = i;
+        }
+        
+        // Hits on the player land first on a tie, as in CombatSystem::resolve
+        if (nextAttack[attacker] <= nextSwing) {
+            float time = nextAttack[attacker];
+            if (time >= options.limit) return;
+            nextAttack[attacker] += enemy.attackCooldown;
+            if (unit(rng) < options.enemyMiss) continue;
+            
+            bool armored = scenario.buff == Buff::ARMOR && time < armorBoost.effectDuration;
+            int armor = stats.defense + (armored ? armorBoost.effectValue : 0);
+            stats.health = std::max(0, stats.health - CombatSystem::mitigate(enemy.attack, armor));
+            if (stats.health == 0) {
+                out.deaths++;
+                out.deathTimes[binOf(time, bins)]++;
+                return;
+            }
+            if (potionLeft && stats.health <= stats.maxHealth / 2) {
+                stats.health = std::min(stats.maxHealth, stats.health + potion.effectValue);
+                potionLeft = false;
+            }
+        } else {
+            // A swing reaches the whole pack
+            float time = nextSwing;
+            if (time >= options.limit) return;
+            nextSwing += Player::ATTACK_COOLDOWN;
+            
+            bool boosted = scenario.buff == Buff::DAMAGE && time < damageBoost.effectDuration;
+            int attack = stats.attack + (boosted ? damageBoost.effectValue : 0);
+            for (int i = 0; i < options.pack; i++) {
+                if (health[i] <= 0 || unit(rng) < options.playerMiss) continue;
+                health[i] = std::max(0, health[i] - CombatSystem::mitigate(attack, enemy.defense));
+                if (health[i] == 0) alive--;
+            }
+            if (alive == 0) {
+                out.wins++;
+                out.healthLeft += stats.health;
+                out.killTimes[binOf(time, bins)]++;
+                return;
+            }
+        }
+    }
+}
+
+// Seconds by which the given share of all fights had ended that way, or -1
+float percentile(const std::vector<std::uint32_t>& histogram, long fights, float share) {
+    long needed = static_cast<long>(fights * share + 0.5f);
+    if (needed <= 0) return -1.0f;
+    long seen = 0;
+    for (size_t bin = 0; bin < histogram.size(); bin++) {
+        seen += histogram[bin];
+        if (seen >= needed) return (bin + 1) * BIN_SECONDS;
+    }
+    return -1.0f;
+}
+
+void printTime(float seconds) {
+    if (seconds < 0.0f) {
+        std::cout << std::setw(8) << "-";
+    } else {
+        std::cout << std::setw(8) << std::fixed << std::setprecision(1) << seconds;
+    }
+}
+
+void writeCsv(const char* path, const std::vector<Scenario>& scenarios, const std::vector<Outcome>& outcomes) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Could not write " << path << std::endl;
+        return;
+    }
+    
+    // survival: share of fights with the player still standing at time;
+    // ttk: share of fights won within that bin
+    file << "enemy,level,buff,time,survival,ttk\n";
+    for (size_t s = 0; s < scenarios.size(); s++) {
+        const Outcome& outcome = outcomes[s];
+        long dead = 0;
+        for (size_t bin = 0; bin < outcome.deathTimes.size(); bin++) {
+            dead += outcome.deathTimes[bin];
+            file << Archetypes::name(scenarios[s].enemy) << ',' << scenarios[s].level << ','
+                 << BUFF_NAMES[static_cast<size_t>(scenarios[s].buff)] << ',' << (bin + 1) * BIN_SECONDS << ','
+                 << 1.0 - static_cast<double>(dead) / outcome.fights << ','
+                 << static_cast<double>(outcome.killTimes[bin]) / outcome.fights << '\n';
+        }
+    }
+    std::cout << "Wrote " << path << std::endl;
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--fights N] [--levels N] [--pack N] [--limit SECONDS]"
+              << " [--player-miss P] [--enemy-miss P] [--seed S] [--threads N] [--csv FILE]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--fights") == 0 && i + 1 < argc) {
+            options.fights = std::max(1L, std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+            options.levels = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc) {
+            options.pack = std::clamp(std::atoi(argv[++i]), 1, MAX_PACK);
+        } else if (std::strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            options.limit = std::max(1.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (std::strcmp(argv[i], "--player-miss") == 0 && i + 1 < argc) {
+            options.playerMiss = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.0f, 0.99f);
+        } else if (std::strcmp(argv[i], "--enemy-miss") == 0 && i + 1 < argc) {
+            options.enemyMiss = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.0f, 0.99f);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            options.csvPath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    Archetypes::loadTuning("tuning.txt");
+    
+    std::vector<Scenario> scenarios;
+    for (size_t enemy = 0; enemy < ENEMY_TYPE_COUNT; enemy++) {
+        for (int level = 1; level <= options.levels; level++) {
+            for (size_t buff = 0; buff < BUFF_COUNT; buff++) {
+                scenarios.push_back(Scenario{ static_cast<EnemyType>(enemy), level, static_cast<Buff>(buff) });
+            }
+        }
+    }
+    
+    // Work items are (scenario, block of fights) pairs, each seeded from its
+    // own indices, so results are the same for any thread count
+    const size_t bins = static_cast<size_t>(options.limit / BIN_SECONDS) + 1;
+    const size_t itemsPerScenario = (options.fights + FIGHTS_PER_ITEM - 1) / FIGHTS_PER_ITEM;
+    std::vector<Outcome> shares(scenarios.size() * itemsPerScenario, Outcome(bins));
+    
+    ThreadPool pool(options.threads);
+    auto start = BalanceClock::now();
+    pool.parallelFor(shares.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t item = begin; item < end; item++) {
+            size_t scenario = item / itemsPerScenario;
+            size_t block = item % itemsPerScenario;
+            std::seed_seq seed{ options.seed, static_cast<unsigned int>(scenario), static_cast<unsigned int>(block) };
+            std::mt19937 rng(seed);
+            long count = std::min<long>(FIGHTS_PER_ITEM, options.fights - static_cast<long>(block * FIGHTS_PER_ITEM));
+            for (long f = 0; f < count; f++) {
+                fight(scenarios[scenario], options, rng, shares[item]);
+            }
+        }
+    });
+    
+    std::vector<Outcome> outcomes(scenarios.size(), Outcome(bins));
+    for (size_t item = 0; item < shares.size(); item++) {
+        outcomes[item / itemsPerScenario].add(shares[item]);
+    }
+    double ms = std::chrono::duration<double, std::milli>(BalanceClock::now() - start).count();
+    
+    long total = options.fights * static_cast<long>(scenarios.size());
+    std::cout << "balance: " << total << " fights in " << ms << " ms on " << pool.getThreadCount() << " thread(s), "
+              << static_cast<long>(total / (ms / 1000.0)) << " fights/sec" << std::endl;
+    std::cout << "  pack of " << options.pack << ", " << options.playerMiss * 100 << "% swings missed, "
+              << options.enemyMiss * 100 << "% enemy attacks missed, " << options.limit << " s limit" << std::endl;
+    
+    // Survival is the share of fights the player lived through (won or ran
+    // out the clock); kill times are over all fights, so a p90 past the win
+    // rate shows as -
+    for (size_t s = 0; s < scenarios.size(); s++) {
+        const Scenario& scenario = scenarios[s];
+        const Outcome& outcome = outcomes[s];
+        if (scenario.level == 1 && scenario.buff == Buff::NONE) {
+            std::cout << Archetypes::name(scenario.enemy) << std::endl;
+            std::cout << "  lvl  buff     survive     win  ttk p10     p50     p90  death p10  hp left" << std::endl;
+        }
+        
+        std::cout << "  " << std::left << std::setw(4) << scenario.level << " " << std::setw(8)
+                  << BUFF_NAMES[static_cast<size_t>(scenario.buff)] << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(7) << 100.0 * (outcome.fights - outcome.deaths) / outcome.fights << "%"
+                  << std::setw(7) << 100.0 * outcome.wins / outcome.fights << "%";
+        printTime(percentile(outcome.killTimes, outcome.fights, 0.1f));
+        printTime(percentile(outcome.killTimes, outcome.fights, 0.5f));
+        printTime(percentile(outcome.killTimes, outcome.fights, 0.9f));
+        std::cout << "   ";
+        printTime(percentile(outcome.deathTimes, outcome.fights, 0.1f));
+        std::cout << std::setw(9) << (outcome.wins > 0 ? outcome.healthLeft / outcome.wins : 0) << std::endl;
+        std::cout << std::defaultfloat << std::setprecision(6);
+    }
+    
+    if (options.csvPath) {
+        writeCsv(options.csvPath, scenarios, outcomes);
+    }
+    return 0;
+}
@@ -0,0 +1,648 @@
+// Performance scenarios for the simulation.
+// Build with `make bench`, then run `./dungeon_benchmark [scenario...]`.
+// With no arguments every scenario runs.
+#include "Combat.h"
+#include "Dungeon.h"
+#include "EnemyStore.h"
+#include "EnemySpawner.h"
+#include "Player.h"
+#include "ProjectileStore.h"
+#include "SimdKernels.h"
+#include "ThreadPool.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+typedef std::chrono::steady_clock BenchClock;
+
+double elapsedMs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// Region labels against a flood fill of the whole grid: tiles share a label
+// exactly when they are connected. Returns the region count, or -1.
+int checkRegions(const Dungeon& dungeon) {
+    const int width = dungeon.getWidth();
+    const int height = dungeon.getHeight();
+    const auto& tiles = dungeon.getTiles();
+    auto regionOf = [&](int index) {
+        return dungeon.getRegion((index % width + 0.5f) * Dungeon::TILE_SIZE, (index / width + 0.5f) * Dungeon::TILE_SIZE);
+    };
+    
+    std::vector<std::uint8_t> seen(tiles.size(), 0);
+    std::unordered_set<std::uint32_t> labels;
+    std::vector<int> frontier;
+    int regions = 0;
+    for (size_t start = 0; start < tiles.size(); start++) {
+        if (seen[start] || Dungeon::isBlocking(tiles[start])) continue;
+        std::uint32_t label = regionOf(start);
+        if (label == 0 || !labels.insert(label).second) return -1;
+        regions++;
+        
+        frontier.assign(1, static_cast<int>(start));
+        seen[start] = 1;
+        while (!frontier.empty()) {
+            int index = frontier.back();
+            frontier.pop_back();
+            if (regionOf(index) != label) return -1;
+            int x = index % width;
+            int y = index / width;
+            const int neighbours[4] = {
+                x > 0 ? index - 1 : -1,
+                x < width - 1 ? index + 1 : -1,
+                y > 0 ? index - width : -1,
+                y < height - 1 ? index + width : -1
+            };
+            for (int neighbour : neighbours) {
+                if (neighbour < 0 || seen[neighbour] || Dungeon::isBlocking(tiles[neighbour])) continue;
+                seen[neighbour] = 1;
+                frontier.push_back(neighbour);
+            }
+        }
+    }
+    return regions;
+}
+
+// Removing enemies the player is standing next to, the last row first, then
+// rows from the middle: the index lists must keep naming live rows, and the
+// distances measured afterwards must match the positions.
+bool checkRemovals() {
+    EnemyStore enemies;
+    enemies.setWorldBounds(2000.0f, 2000.0f);
+    const sf::Vector2f playerPos(1000.0f, 1000.0f);
+    for (int i = 0; i < 12; i++) {
+        enemies.spawn(EnemyType::GOBLIN, playerPos.x + (i % 4) * 30.0f - 45.0f, playerPos.y + (i / 4) * 30.0f - 30.0f);
+    }
+    enemies.update(1.0f / 60.0f, playerPos, playerPos);
+    
+    for (size_t i : { size_t(11), size_t(3), size_t(9), size_t(0) }) {
+        enemies.remove(i);
+        if (!enemies.indicesValid()) return false;
+        enemies.update(1.0f / 60.0f, playerPos, playerPos);
+        if (!enemies.indicesValid()) return false;
+        for (size_t j = 0; j < enemies.size(); j++) {
+            sf::Vector2f pos = enemies.getPosition(j);
+            if (std::abs(enemies.getPlayerDistance(j) - std::hypot(pos.x - playerPos.x, pos.y - playerPos.y)) > 0.5f) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Destructible-terrain load: a burst of tile edits every frame, each followed by the
+// incremental refresh of collision, regions, navigation, FOV and render chunks.
+void benchTileEdits() {
+    const int size = 256;
+    const int frames = 600;
+    const int editsPerFrame = 64;
+    
+    Dungeon dungeon(size, size);
+    dungeon.generate(12345u, false);
+    
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> nearDist(-Dungeon::NAV_RADIUS, Dungeon::NAV_RADIUS);
+    sf::Vector2f focus = dungeon.getPlayerSpawn();
+    sf::FloatRect view(focus.x - 600, focus.y - 400, 1200, 800);
+    
+    // Warm the caches once so the loop measures incremental work only
+    dungeon.updateDerived(focus);
+    dungeon.refreshChunks(view);
+    
+    auto start = BenchClock::now();
+    double worstFrame = 0.0;
+    for (int frame = 0; frame < frames; frame++) {
+        auto frameStart = BenchClock::now();
+        dungeon.setTick(frame);
+        
+        // Edits land around the focus so they hit the windowed layers
+        for (int i = 0; i < editsPerFrame; i++) {
+            float x = focus.x + nearDist(rng) * Dungeon::TILE_SIZE;
+            float y = focus.y + nearDist(rng) * Dungeon::TILE_SIZE;
+            TileType type = dungeon.getTileType(x, y) == TileType::CRACKED_WALL ? TileType::FLOOR : TileType::CRACKED_WALL;
+            dungeon.setTileTypeAt(x, y, type);
+        }
+        
+        dungeon.updateDerived(focus);
+        dungeon.refreshChunks(view);
+        worstFrame = std::max(worstFrame, elapsedMs(frameStart));
+    }
+    double totalMs = elapsedMs(start);
+    
+    long edits = static_cast<long>(frames) * editsPerFrame;
+    std::cout << "tiles: " << edits << " edits over " << frames << " frames in " << totalMs << " ms" << std::endl;
+    std::cout << "  " << static_cast<long>(edits / (totalMs / 1000.0)) << " edits/sec, "
+              << totalMs / frames << " ms/frame avg, " << worstFrame << " ms worst" << std::endl;
+    std::cout << "  journal holds " << dungeon.getJournal().size() << " entries" << std::endl;
+    
+    // Seal a corridor with a cracked wall, then break it: the two sides
+    // must go from separate regions to one
+    bool joined = false;
+    const int width = dungeon.getWidth();
+    for (int y = 1; y < dungeon.getHeight() - 1 && !joined; y++) {
+        for (int x = 1; x < width - 1 && !joined; x++) {
+            const auto& tiles = dungeon.getTiles();
+            int index = y * width + x;
+            if (tiles[index] != TileType::FLOOR || !Dungeon::isBlocking(tiles[index - width]) ||
+                !Dungeon::isBlocking(tiles[index + width]) || Dungeon::isBlocking(tiles[index - 1]) ||
+                Dungeon::isBlocking(tiles[index + 1])) {
+                continue;
+            }
+            
+            float left = (x - 0.5f) * Dungeon::TILE_SIZE;
+            float right = (x + 1.5f) * Dungeon::TILE_SIZE;
+            float middle = (x + 0.5f) * Dungeon::TILE_SIZE;
+            float row = (y + 0.5f) * Dungeon::TILE_SIZE;
+            dungeon.setTileTypeAt(middle, row, TileType::CRACKED_WALL);
+            dungeon.updateDerived(focus);
+            bool split = dungeon.getRegion(left, row) != dungeon.getRegion(right, row);
+            dungeon.setTileTypeAt(middle, row, TileType::FLOOR);
+            dungeon.updateDerived(focus);
+            joined = split && dungeon.getRegion(left, row) == dungeon.getRegion(right, row);
+        }
+    }
+    int regions = checkRegions(dungeon);
+    if (regions < 0) {
+        std::cout << "  regions: MISMATCH with a full flood fill";
+    } else {
+        std::cout << "  regions: " << regions << " connected areas, same as a full flood fill";
+    }
+    std::cout << "; breaking a wall " << (joined ? "joins two regions" : "DID NOT join two regions") << std::endl;
+}
+
+// Horde load: 50k enemies ticked at 60 Hz on one core. The budget is 16.6 ms per tick.
+void benchEnemies() {
+    const int count = 50000;
+    const int ticks = 600;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    EnemyStore enemies;
+    enemies.reserve(count);
+    enemies.setWorldBounds(8000.0f, 8000.0f);
+    
+    // Every enemy every tick; level of detail has its own scenario
+    AILodSettings everyFrame;
+    everyFrame.enabled = false;
+    enemies.setLodSettings(everyFrame);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(0.0f, 8000.0f);
+    for (int i = 0; i < count; i++) {
+        enemies.spawn(static_cast<EnemyType>(i % 3), coord(rng), coord(rng));
+    }
+    
+    // The player circles the middle of the field so enemies keep switching state
+    auto start = BenchClock::now();
+    double worstTick = 0.0;
+    size_t inRange = 0, thinking = 0, perceptionChecks = 0;
+    const AIState states[] = { AIState::IDLE, AIState::PATROL, AIState::CHASE, AIState::ATTACK };
+    const char* stateNames[] = { "idle", "patrol", "chase", "attack" };
+    std::int64_t stateMicros[4] = {};
+    std::vector<std::uint32_t> nearby;
+    for (int tick = 0; tick < ticks; tick++) {
+        auto tickStart = BenchClock::now();
+        float angle = tick * 0.01f;
+        sf::Vector2f playerPos(4000.0f + std::cos(angle) * 2000.0f, 4000.0f + std::sin(angle) * 2000.0f);
+        
+        enemies.update(deltaTime, playerPos, playerPos);
+        enemies.queryRadius(playerPos, 60.0f, nearby);
+        inRange += nearby.size();
+        thinking += enemies.getTickedCount();
+        perceptionChecks += enemies.getSensedSquadCount();
+        for (int s = 0; s < 4; s++) {
+            stateMicros[s] += enemies.getStateTime(states[s]).asMicroseconds();
+        }
+        worstTick = std::max(worstTick, elapsedMs(tickStart));
+    }
+    double totalMs = elapsedMs(start);
+    
+    std::cout << "enemies: " << count << " enemies x " << ticks << " ticks in " << totalMs << " ms" << std::endl;
+    std::cout << "  " << totalMs / ticks << " ms/tick avg, " << worstTick << " ms worst (budget 16.6 ms), "
+              << inRange << " in-range hits" << std::endl;
+    std::cout << "  " << thinking / ticks << " enemies thinking per tick, " << perceptionChecks / ticks
+              << " squad perception checks per tick (" << enemies.getSquadCount() << " squads)" << std::endl;
+    std::cout << "  by state at the end (ms/tick in its loop; idle is timer upkeep):";
+    for (int s = 0; s < 4; s++) {
+        std::cout << " " << stateNames[s] << " " << enemies.getStateCount(states[s])
+                  << " (" << stateMicros[s] / 1000.0 / ticks << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "  removals next to the player: " << (checkRemovals() ? "index lists stay valid" : "FAILED") << std::endl;
+}
+
+// AI level of detail: enemy density stays fixed while the world grows, so the
+// number near the view stays the same. Frame cost, update plus the render
+// snapshot of the view, should stay roughly flat.
+void benchLod() {
+    const float density = 50000.0f / (8000.0f * 8000.0f);
+    const int ticks = 600;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    std::cout << "lod: constant density, growing world, " << ticks << " ticks" << std::endl;
+    for (float worldSize : { 4000.0f, 8000.0f, 16000.0f, 32000.0f }) {
+        const int count = static_cast<int>(density * worldSize * worldSize);
+        EnemyStore enemies;
+        enemies.reserve(count);
+        enemies.setWorldBounds(worldSize, worldSize);
+        std::mt19937 rng(19);
+        std::uniform_real_distribution<float> coord(0.0f, worldSize);
+        for (int i = 0; i < count; i++) {
+            enemies.spawn(static_cast<EnemyType>(i % 3), coord(rng), coord(rng));
+        }
+        
+        EnemySnapshot snapshot;
+        snapshot.reserve(count);
+        size_t ticked = 0, drawn = 0;
+        auto start = BenchClock::now();
+        for (int tick = 0; tick < ticks; tick++) {
+            float angle = tick * 0.01f;
+            sf::Vector2f playerPos(worldSize / 2 + std::cos(angle) * 1000.0f, worldSize / 2 + std::sin(angle) * 1000.0f);
+            enemies.update(deltaTime, playerPos, playerPos);
+            enemies.writeSnapshot(snapshot, sf::FloatRect(playerPos.x - 600.0f, playerPos.y - 400.0f, 1200.0f, 800.0f));
+            ticked += enemies.getTickedCount();
+            drawn += snapshot.size();
+        }
+        double totalMs = elapsedMs(start);
+        
+        std::cout << "  " << count << " enemies: " << totalMs / ticks << " ms/tick, "
+                  << ticked / ticks << " AI updates/tick, " << drawn / ticks << " in the snapshot/tick, "
+                  << enemies.getSleepingCount() << " asleep" << std::endl;
+    }
+}
+
+// Horde: thousands of alerted goblins chase the player from room to room
+// through corridors. Run with and without crowd steering; "stacked" counts
+// goblins within 2 px of another at the end.
+void benchHorde() {
+    // The floor has about 540 open tiles, so a bigger pack would overlap
+    // whatever the steering did
+    const int size = 128;
+    const int count = 500;
+    const int stepsPerRoom = 300;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    size_t stackedBySteering[2] = { 0, 0 };
+    for (bool steering : { false, true }) {
+        Dungeon dungeon(size, size);
+        dungeon.generate(777u, false);
+        
+        EnemyStore enemies;
+        enemies.reserve(count);
+        enemies.setWorldBounds(size * Dungeon::TILE_SIZE, size * Dungeon::TILE_SIZE);
+        enemies.setDungeon(&dungeon);
+        CrowdSettings crowd;
+        crowd.enabled = steering;
+        enemies.setCrowdSettings(crowd);
+        
+        // The pack starts one to a tile on the floor tiles nearest the spawn
+        sf::Vector2f playerPos = dungeon.getPlayerSpawn();
+        const auto& tiles = dungeon.getTiles();
+        std::vector<std::pair<float, int>> floorTiles;
+        for (int tile = 0; tile < static_cast<int>(tiles.size()); tile++) {
+            if (Dungeon::isBlocking(tiles[tile])) continue;
+            float dx = (tile % size + 0.5f) * Dungeon::TILE_SIZE - playerPos.x;
+            float dy = (tile / size + 0.5f) * Dungeon::TILE_SIZE - playerPos.y;
+            floorTiles.push_back(std::make_pair(dx * dx + dy * dy, tile));
+        }
+        std::sort(floorTiles.begin(), floorTiles.end());
+        std::mt19937 rng(23);
+        std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+        for (size_t n = 0; n < floorTiles.size() && static_cast<int>(enemies.size()) < count; n++) {
+            int tile = floorTiles[n].second;
+            float x = (tile % size + 0.5f) * Dungeon::TILE_SIZE + jitter(rng);
+            float y = (tile / size + 0.5f) * Dungeon::TILE_SIZE + jitter(rng);
+            enemies.alert(enemies.spawn(EnemyType::GOBLIN, x, y));
+        }
+        
+        size_t chasing = 0;
+        int ticks = 0;
+        auto start = BenchClock::now();
+        for (int room = 1; room < dungeon.getRoomCount(); room++) {
+            sf::FloatRect bounds = dungeon.getRoomBounds(room);
+            sf::Vector2f target(bounds.left + bounds.width / 2, bounds.top + bounds.height / 2);
+            sf::Vector2f from = playerPos;
+            for (int step = 1; step <= stepsPerRoom; step++) {
+                playerPos = from + (target - from) * (static_cast<float>(step) / stepsPerRoom);
+                dungeon.updateDerived(playerPos);
+                
+                // Keep the whole pack hunting, even stragglers past their leash
+                for (size_t i = 0; i < enemies.size(); i++) {
+                    if (enemies.getState(i) != AIState::ATTACK) enemies.alert(i);
+                }
+                enemies.update(deltaTime, playerPos, playerPos);
+                for (size_t i = 0; i < enemies.size(); i++) {
+                    chasing += enemies.getState(i) == AIState::CHASE || enemies.getState(i) == AIState::ATTACK;
+                }
+                ticks++;
+            }
+        }
+        double totalMs = elapsedMs(start);
+        
+        // Goblins sharing a spot with another, and how far apart neighbours sit
+        size_t stacked = 0;
+        double spacing = 0.0;
+        std::vector<std::uint32_t> nearby;
+        for (size_t i = 0; i < enemies.size(); i++) {
+            sf::Vector2f pos = enemies.getPosition(i);
+            enemies.queryRadius(pos, EnemyStore::ENEMY_SIZE, nearby);
+            float closest = EnemyStore::ENEMY_SIZE;
+            for (std::uint32_t j : nearby) {
+                if (j == i) continue;
+                sf::Vector2f other = enemies.getPosition(j);
+                closest = std::min(closest, std::hypot(pos.x - other.x, pos.y - other.y));
+            }
+            stacked += closest < 2.0f;
+            spacing += closest;
+        }
+        stackedBySteering[steering] = stacked;
+        
+        std::cout << "horde (" << (steering ? "steering" : "seek only") << "): " << enemies.size() << " goblins, "
+                  << ticks << " ticks in " << totalMs << " ms" << std::endl;
+        std::cout << "  " << totalMs / ticks << " ms/tick, " << chasing / ticks << " chasing on average" << std::endl;
+        std::cout << "  at the end: " << stacked << " on the same spot as another, nearest neighbour "
+                  << spacing / enemies.size() << " px on average (capped at " << EnemyStore::ENEMY_SIZE << ")" << std::endl;
+    }
+    std::cout << "horde: steering leaves " << stackedBySteering[1] << " goblins on another's spot, against "
+              << stackedBySteering[0] << " with seek only" << std::endl;
+}
+
+// Lazy spawning on a large floor: every room holds dormant records, and the
+// player walks from room to room. Live enemies should stay a small fraction.
+void benchSpawner() {
+    const int size = 256;
+    const int recordCount = 20000;
+    const int stepsPerRoom = 240;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    Dungeon dungeon(size, size);
+    dungeon.generate(4242u, false);
+    
+    EnemyStore enemies;
+    enemies.setWorldBounds(size * Dungeon::TILE_SIZE, size * Dungeon::TILE_SIZE);
+    EnemySpawner spawner;
+    spawner.reset(dungeon);
+    int typeIndex = 0;
+    for (const sf::Vector2f& spawn : dungeon.getEnemySpawns(recordCount)) {
+        spawner.addRecord(static_cast<EnemyType>(typeIndex++ % 3), spawn.x, spawn.y);
+    }
+    
+    size_t peakLive = 0, totalLive = 0;
+    int ticks = 0;
+    auto start = BenchClock::now();
+    sf::Vector2f playerPos = dungeon.getPlayerSpawn();
+    for (int room = 0; room < dungeon.getRoomCount(); room++) {
+        sf::FloatRect bounds = dungeon.getRoomBounds(room);
+        sf::Vector2f target(bounds.left + bounds.width / 2, bounds.top + bounds.height / 2);
+        sf::Vector2f from = playerPos;
+        for (int step = 1; step <= stepsPerRoom; step++) {
+            float t = static_cast<float>(step) / stepsPerRoom;
+            playerPos = from + (target - from) * t;
+            spawner.update(playerPos, enemies);
+            enemies.update(deltaTime, playerPos, playerPos);
+            peakLive = std::max(peakLive, enemies.size());
+            totalLive += enemies.size();
+            ticks++;
+        }
+    }
+    double totalMs = elapsedMs(start);
+    
+    std::cout << "spawner: " << recordCount << " records in " << spawner.getRoomCount() << " rooms, "
+              << ticks << " ticks in " << totalMs << " ms" << std::endl;
+    std::cout << "  " << totalMs / ticks << " ms/tick, live enemies avg " << totalLive / ticks
+              << ", peak " << peakLive << ", dormant at end " << spawner.getDormantCount() << std::endl;
+}
+
+// Enemy update scaling across worker counts, 1..hardware threads. Every run
+// starts from the same spawn set and must end in the same state hash.
+void benchThreads() {
+    const int count = 200000;
+    const int ticks = 300;
+    const float deltaTime = 1.0f / 60.0f;
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    
+    std::uint64_t referenceHash = 0;
+    double singleMs = 0.0;
+    std::cout << "threads: " << count << " enemies x " << ticks << " ticks" << std::endl;
+    for (size_t threads = 1; threads <= maxThreads; threads = threads < maxThreads ? std::min(threads * 2, maxThreads) : threads + 1) {
+        ThreadPool pool(threads);
+        EnemyStore enemies;
+        enemies.reserve(count);
+        enemies.setWorldBounds(8000.0f, 8000.0f);
+        enemies.setThreadPool(&pool);
+        
+        // Every enemy every frame, so the whole store goes through the pool
+        AILodSettings everyFrame;
+        everyFrame.enabled = false;
+        enemies.setLodSettings(everyFrame);
+        std::mt19937 rng(17);
+        std::uniform_real_distribution<float> coord(0.0f, 8000.0f);
+        for (int i = 0; i < count; i++) {
+            enemies.spawn(static_cast<EnemyType>(i % 3), coord(rng), coord(rng));
+        }
+        
+        auto start = BenchClock::now();
+        for (int tick = 0; tick < ticks; tick++) {
+            float angle = tick * 0.01f;
+            sf::Vector2f playerPos(4000.0f + std::cos(angle) * 2000.0f, 4000.0f + std::sin(angle) * 2000.0f);
+            enemies.update(deltaTime, playerPos, playerPos);
+        }
+        double totalMs = elapsedMs(start);
+        
+        std::uint64_t hash = enemies.stateHash();
+        if (threads == 1) {
+            referenceHash = hash;
+            singleMs = totalMs;
+        }
+        std::cout << "  " << threads << " thread(s): " << totalMs / ticks << " ms/tick, "
+                  << singleMs / totalMs << "x, state " << std::hex << hash << std::dec
+                  << (hash == referenceHash ? " (identical)" : " (DIFFERS)") << std::endl;
+    }
+}
+
+// Perception kernels over one batch, per instruction set. Each path runs the same
+// distance, range-mask and direction passes; outputs are checked against scalar.
+void benchSimdKernels() {
+    const size_t count = 1 << 16;
+    const int passes = 2000;
+    
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> coord(0.0f, 8000.0f);
+    std::vector<float> x(count), y(count);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+    }
+    x[0] = 4000.0f; // One enemy on top of the player covers the zero-length case
+    y[0] = 4000.0f;
+    
+    struct Path {
+        const char* name;
+        bool available;
+        void (*distanceSquared)(const float*, const float*, size_t, float, float, float*);
+        void (*rangeMask)(const float*, size_t, float, std::uint8_t*);
+        void (*directionTo)(const float*, const float*, size_t, float, float, float*, float*, float*);
+    };
+    const Path paths[] = {
+        { "scalar", true, simd::scalar::distanceSquared, simd::scalar::rangeMask, simd::scalar::directionTo },
+        { "SSE2", simd::sse2::available(), simd::sse2::distanceSquared, simd::sse2::rangeMask, simd::sse2::directionTo },
+        { "AVX2", simd::avx2::available(), simd::avx2::distanceSquared, simd::avx2::rangeMask, simd::avx2::directionTo },
+    };
+    
+    std::vector<float> distSq(count), dirX(count), dirY(count), distance(count);
+    std::vector<std::uint8_t> mask(count);
+    std::vector<float> referenceDirX, referenceDistance;
+    std::vector<std::uint8_t> referenceMask;
+    double scalarMs = 0.0;
+    
+    std::cout << "simd: " << count << " entities x " << passes << " passes, dispatch picks "
+              << simd::activeInstructionSet() << std::endl;
+    for (const Path& path : paths) {
+        if (!path.available) {
+            std::cout << "  " << path.name << ": not supported on this CPU" << std::endl;
+            continue;
+        }
+        
+        size_t inRange = 0;
+        auto start = BenchClock::now();
+        for (int pass = 0; pass < passes; pass++) {
+            float px = 4000.0f + (pass % 7);
+            path.distanceSquared(x.data(), y.data(), count, px, 4000.0f, distSq.data());
+            path.rangeMask(distSq.data(), count, 300.0f, mask.data());
+            path.directionTo(x.data(), y.data(), count, px, 4000.0f, dirX.data(), dirY.data(), distance.data());
+            inRange += mask[pass % count];
+        }
+        double totalMs = elapsedMs(start);
+        
+        // Last pass results must match the scalar reference exactly
+        bool matches = true;
+        if (referenceDistance.empty()) {
+            referenceDirX = dirX;
+            referenceDistance = distance;
+            referenceMask = mask;
+            scalarMs = totalMs;
+        } else {
+            matches = dirX == referenceDirX && distance == referenceDistance && mask == referenceMask;
+        }
+        
+        double entitiesPerSec = static_cast<double>(count) * passes / (totalMs / 1000.0);
+        std::cout << "  " << path.name << ": " << totalMs / passes << " ms/pass, "
+                  << static_cast<long>(entitiesPerSec / 1e6) << "M entities/sec, "
+                  << scalarMs / totalMs << "x scalar, " << (matches ? "matches scalar" : "MISMATCH")
+                  << " (" << inRange << ")" << std::endl;
+    }
+}
+
+// Projectile storm: 20k arrows and thrown weapons in flight at once, topped
+// up every tick. Each tick moves them with swept wall tests, resolves hits
+// against the player and a field of goblins through the enemy grid, and
+// builds the single batched draw. The budget is 16.6 ms per tick.
+void benchProjectiles() {
+    const int size = 128;
+    const size_t projectileCount = 20000;
+    const size_t enemyCount = 1000;
+    const int ticks = 600;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    Dungeon dungeon(size, size);
+    dungeon.generate(4242u, false);
+    EnemyStore enemies;
+    enemies.reserve(enemyCount);
+    enemies.setWorldBounds(size * Dungeon::TILE_SIZE, size * Dungeon::TILE_SIZE);
+    ProjectileStore projectiles(projectileCount);
+    CombatSystem combat;
+    sf::Vector2f playerPos = dungeon.getPlayerSpawn();
+    Player player(playerPos.x, playerPos.y);
+    
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> coord(0.0f, size * Dungeon::TILE_SIZE);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    auto floorPoint = [&]() {
+        sf::Vector2f point;
+        do {
+            point = sf::Vector2f(coord(rng), coord(rng));
+        } while (dungeon.isWall(point.x, point.y));
+        return point;
+    };
+    
+    size_t spawned = 0, hits = 0, walls = 0;
+    double tickMs = 0.0, buildMs = 0.0;
+    double worstTick = 0.0;
+    auto start = BenchClock::now();
+    for (int tick = 0; tick < ticks; tick++) {
+        // Top up both sides; losses are wall hits, timeouts and entity hits
+        while (enemies.size() < enemyCount) {
+            sf::Vector2f point = floorPoint();
+            enemies.spawn(EnemyType::GOBLIN, point.x, point.y);
+        }
+        while (projectiles.size() < projectileCount) {
+            float a = angle(rng);
+            ProjectileOwner owner = spawned % 2 ? ProjectileOwner::ENEMY : ProjectileOwner::PLAYER;
+            projectiles.spawn(owner, floorPoint(), sf::Vector2f(std::cos(a), std::sin(a)) * 300.0f, 10);
+            spawned++;
+        }
+        
+        auto tickStart = BenchClock::now();
+        size_t before = projectiles.size();
+        projectiles.update(deltaTime, &dungeon);
+        size_t afterMove = projectiles.size();
+        combat.projectileHits(projectiles, enemies, playerPos, Player::PLAYER_SIZE / 2);
+        hits += afterMove - projectiles.size();
+        walls += before - afterMove;
+        combat.resolve(enemies, player); // The player's health bottoms out at 0; it keeps taking hits
+        
+        auto buildStart = BenchClock::now();
+        const sf::VertexArray& batch = projectiles.buildVertices();
+        buildMs += elapsedMs(buildStart);
+        if (batch.getVertexCount() != projectiles.size() * 4) {
+            std::cout << "  batch size mismatch" << std::endl;
+        }
+        double thisTick = elapsedMs(tickStart);
+        tickMs += thisTick;
+        worstTick = std::max(worstTick, thisTick);
+    }
+    double totalMs = elapsedMs(start);
+    
+    std::cout << "projectiles: " << projectileCount << " in flight, " << enemyCount << " goblins, "
+              << ticks << " ticks in " << totalMs << " ms (including top-ups)" << std::endl;
+    std::cout << "  " << tickMs / ticks << " ms/tick avg, " << worstTick << " ms worst (budget 16.6 ms), of which "
+              << buildMs / ticks << " ms building the single draw batch" << std::endl;
+    std::cout << "  " << hits / ticks << " entity hits and " << walls / ticks << " wall stops or timeouts per tick" << std::endl;
+}
+
+struct Scenario {
+    const char* name;
+    void (*run)();
+};
+
+const Scenario scenarios[] = {
+    { "tiles", benchTileEdits },
+    { "enemies", benchEnemies },
+    { "lod", benchLod },
+    { "horde", benchHorde },
+    { "spawner", benchSpawner },
+    { "threads", benchThreads },
+    { "simd", benchSimdKernels },
+    { "projectiles", benchProjectiles },
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (const auto& scenario : scenarios) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], scenario.name) == 0) selected = true;
+        }
+        if (selected) {
+            scenario.run();
+        }
+    }
+    return 0;
+}
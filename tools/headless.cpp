@@ -0,0 +1,289 @@
+// Runs the simulation with no window, as fast as the machine allows, for
+// soak tests and performance gates on machines without a display.
+// Build with `make headless`, then
+//
+//     ./dungeon_headless [--games N] [--jobs N] [--ticks N] [--seed S] [--bot] [--tick-rate N] [--threads N] [--verbose]
+//
+// A game is one run from its seed until the player dies or --ticks ticks
+// pass; cleared floors are descended at once. Games use seeds S, S+1, ...
+// and play out the same way every time. By default a scripted player
+// wanders and swings; --bot plays with BotInput instead.
+//
+// With more than one game, each is played in a child process, --jobs at a
+// time, so a crash loses only that game and names its seed, and peak memory
+// is the game's own.
+#include "Archetypes.h"
+#include "BotInput.h"
+#include "InputSource.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+typedef std::chrono::steady_clock HeadlessClock;
+
+struct Options {
+    long games = 1;
+    long jobs = 1;
+    long ticks = 36000; // Ten minutes of play at 60 Hz
+    unsigned int seed = 1;
+    bool bot = false;
+    int tickRate = 60;
+    size_t threads = 1;
+    bool verbose = false;
+};
+
+// Written by a child process down a pipe, so plain data only
+struct GameReport {
+    unsigned int seed;
+    long ticks;
+    long floorsCleared;
+    bool died;
+    int score;
+    double totalMs;
+    float p99Ms;
+    float worstMs;
+    long peakKb;
+};
+
+// Wanders in straight legs of up to two seconds, turning early when a wall
+// stops it, swinging twice a second and throwing now and then. Every choice
+// follows from the seed and the player's position, so runs repeat exactly.
+class WanderInput : public InputSource {
+private:
+    const Simulation& sim;
+    unsigned int seed;
+    std::uint32_t leg;
+    std::uint32_t legStart;
+    sf::Vector2f lastPosition;
+
+public:
+    WanderInput(const Simulation& simulation, unsigned int seed)
+        : sim(simulation), seed(seed), leg(0), legStart(0) {}
+    
+    InputCommand sample(std::uint32_t tick) override {
+        static const std::int8_t DIRECTIONS[8][2] = {
+            { 127, 0 }, { 90, 90 }, { 0, 127 }, { -90, 90 }, { -127, 0 }, { -90, -90 }, { 0, -127 }, { 90, -90 }
+        };
+        sf::Vector2f position = sim.getPlayer()->getPosition();
+        if (tick - legStart >= 120 || (tick - legStart > 1 && position == lastPosition)) {
+            leg++;
+            legStart = tick;
+        }
+        lastPosition = position;
+        
+        std::uint32_t pick = (leg * 2654435761u) ^ seed;
+        pick ^= pick >> 15;
+        
+        InputCommand command;
+        command.moveX = DIRECTIONS[pick % 8][0];
+        command.moveY = DIRECTIONS[pick % 8][1];
+        if (tick % 30 == 0) command.buttons |= BUTTON_ATTACK;
+        if (tick % 150 == 75) command.buttons |= BUTTON_THROW;
+        return command;
+    }
+};
+
+long peakMemoryKb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Bytes on macOS, kilobytes elsewhere
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+GameReport playGame(const Options& options, unsigned int seed) {
+    Simulation sim(1200.0f, 800.0f, options.threads);
+    std::unique_ptr<InputSource> input;
+    if (options.bot) {
+        input = std::make_unique<BotInput>(sim);
+    } else {
+        input = std::make_unique<WanderInput>(sim, seed);
+    }
+    const float step = 1.0f / options.tickRate;
+    
+    GameReport report = GameReport();
+    report.seed = seed;
+    std::vector<float> tickTimes;
+    tickTimes.reserve(options.ticks);
+    
+    sim.startRun(seed);
+    auto start = HeadlessClock::now();
+    while (report.ticks < options.ticks) {
+        auto tickStart = HeadlessClock::now();
+        sim.tick(step, input->sample(sim.getTick() + 1));
+        tickTimes.push_back(std::chrono::duration<float, std::milli>(HeadlessClock::now() - tickStart).count());
+        report.ticks++;
+        
+        if (sim.getState() == GameState::VICTORY) {
+            report.floorsCleared++;
+            sim.nextLevel();
+        } else if (sim.getState() == GameState::GAME_OVER) {
+            report.died = true;
+            break;
+        }
+    }
+    report.totalMs = std::chrono::duration<double, std::milli>(HeadlessClock::now() - start).count();
+    report.score = sim.getScore();
+    
+    std::sort(tickTimes.begin(), tickTimes.end());
+    if (!tickTimes.empty()) {
+        report.p99Ms = tickTimes[tickTimes.size() * 99 / 100];
+        report.worstMs = tickTimes.back();
+    }
+    report.peakKb = peakMemoryKb();
+    return report;
+}
+
+void printReport(const GameReport& report) {
+    std::cout << "  seed " << report.seed << ": " << report.floorsCleared << " floors cleared, "
+              << (report.died ? "died" : "alive") << " at tick " << report.ticks << ", score " << report.score
+              << ", " << static_cast<long>(report.ticks / (report.totalMs / 1000.0)) << " ticks/sec, "
+              << report.p99Ms << " ms p99, " << report.worstMs << " worst, peak " << report.peakKb / 1024 << " MB"
+              << std::endl;
+}
+
+// Forks a child per game, at most options.jobs alive at once. Reports come
+// back through one pipe per child; a child that ends without writing one
+// crashed.
+void playForked(const Options& options, std::vector<GameReport>& reports, std::vector<unsigned int>& crashed) {
+    struct Child {
+        pid_t pid;
+        int pipe;
+        unsigned int seed;
+    };
+    std::vector<Child> running;
+    long started = 0;
+    while (started < options.games || !running.empty()) {
+        while (started < options.games && static_cast<long>(running.size()) < options.jobs) {
+            unsigned int seed = options.seed + static_cast<unsigned int>(started++);
+            int fds[2];
+            if (pipe(fds) != 0) {
+                crashed.push_back(seed);
+                continue;
+            }
+            std::cout.flush();
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(fds[0]);
+                GameReport report = playGame(options, seed);
+                ssize_t written = write(fds[1], &report, sizeof(report));
+                _exit(written == static_cast<ssize_t>(sizeof(report)) ? 0 : 1);
+            }
+            close(fds[1]);
+            if (pid < 0) {
+                close(fds[0]);
+                crashed.push_back(seed);
+                continue;
+            }
+            running.push_back(Child{ pid, fds[0], seed });
+        }
+        
+        int status = 0;
+        pid_t done = wait(&status);
+        if (done < 0) break;
+        auto child = std::find_if(running.begin(), running.end(), [done](const Child& c) { return c.pid == done; });
+        if (child == running.end()) continue;
+        
+        // A report is far below the pipe's buffer, so it was written in full
+        // before the child exited
+        GameReport report;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+            read(child->pipe, &report, sizeof(report)) == static_cast<ssize_t>(sizeof(report))) {
+            reports.push_back(report);
+        } else {
+            crashed.push_back(child->seed);
+            std::cerr << "  seed " << child->seed << ": CRASHED ("
+                      << (WIFSIGNALED(status) ? "signal " : "exit ")
+                      << (WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status)) << ")" << std::endl;
+        }
+        close(child->pipe);
+        running.erase(child);
+    }
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--games N] [--jobs N] [--ticks N] [--seed S] [--bot] [--tick-rate N]"
+              << " [--threads N] [--verbose]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            options.games = std::max(1L, std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            options.jobs = std::max(1L, std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            options.ticks = std::max(1L, std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--bot") == 0) {
+            options.bot = true;
+        } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            options.tickRate = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    
+    // The simulation narrates every hit and pickup; that's noise at this speed
+    std::streambuf* console = std::cout.rdbuf();
+    if (!options.verbose) {
+        std::cout.rdbuf(nullptr);
+    }
+    Archetypes::loadTuning("tuning.txt");
+    
+    std::vector<GameReport> reports;
+    std::vector<unsigned int> crashed;
+    auto start = HeadlessClock::now();
+    if (options.games == 1) {
+        reports.push_back(playGame(options, options.seed));
+    } else {
+        playForked(options, reports, crashed);
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(HeadlessClock::now() - start).count();
+    
+    std::cout.rdbuf(console);
+    std::sort(reports.begin(), reports.end(), [](const GameReport& a, const GameReport& b) { return a.seed < b.seed; });
+    
+    long ticks = 0, floorsCleared = 0, deaths = 0, peakKb = 0;
+    float worstMs = 0.0f;
+    for (const GameReport& report : reports) {
+        ticks += report.ticks;
+        floorsCleared += report.floorsCleared;
+        deaths += report.died ? 1 : 0;
+        peakKb = std::max(peakKb, report.peakKb);
+        worstMs = std::max(worstMs, report.worstMs);
+    }
+    
+    std::cout << "headless: " << options.games << " game(s), seeds " << options.seed << "-"
+              << options.seed + options.games - 1 << ", " << (options.bot ? "bot" : "wander script") << ", "
+              << options.ticks << " ticks max at " << options.tickRate << " Hz" << std::endl;
+    for (const GameReport& report : reports) {
+        printReport(report);
+    }
+    std::cout << "  total: " << ticks << " ticks in " << wallMs << " ms on " << std::min(options.jobs, options.games)
+              << " job(s), " << static_cast<long>(ticks / (wallMs / 1000.0)) << " ticks/sec" << std::endl;
+    std::cout << "  " << floorsCleared << " floors cleared, " << deaths << " deaths, " << crashed.size()
+              << " crashed, worst tick " << worstMs << " ms, largest peak " << peakKb / 1024 << " MB" << std::endl;
+    return crashed.empty() ? 0 : 2;
+}